@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+
+const std::string fens[] = {
+    "startpos",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+// The old implementation, generate everything and search
+[[nodiscard]] bool search_legal_moves(const libchess::Position &pos, const libchess::Move &move) {
+    libchess::MoveList moves;
+    pos.legal_moves(moves);
+    return moves.contains(move);
+}
+
+// Compares Position::is_legal() against searching the legal move list
+int main(int argc, char **argv) {
+    int iterations = 20;
+
+    if (argc > 1) {
+        iterations = std::stoi(std::string(argv[1]));
+        iterations = std::max(iterations, 1);
+    }
+
+    // Candidate moves are taken from the positions and their children, much like stale hash moves
+    // Each position's CheckInfo is computed as it's reached, as it would be in a search, so neither pass pays for it
+    std::vector<libchess::Position> positions;
+    std::vector<libchess::Move> candidates;
+    for (const auto &fen : fens) {
+        auto pos = libchess::Position(fen);
+        positions.push_back(pos);
+        for (const auto &move : pos.legal_moves()) {
+            candidates.push_back(move);
+            pos.makemove(move);
+            positions.push_back(pos);
+            const auto replies = pos.legal_moves();
+            candidates.insert(candidates.end(), replies.begin(), replies.end());
+            pos.undomove();
+        }
+    }
+
+    std::uint64_t checks = 0;
+    std::uint64_t legal_search = 0;
+    std::uint64_t legal_direct = 0;
+
+    // The direct pass goes first on untouched positions, so it gets nothing warmed up by the search pass
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto &pos : positions) {
+            for (std::size_t j = i; j < candidates.size(); j += 64) {
+                legal_direct += pos.is_legal(candidates[j]);
+                checks++;
+            }
+        }
+    }
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto &pos : positions) {
+            for (std::size_t j = i; j < candidates.size(); j += 64) {
+                legal_search += search_legal_moves(pos, candidates[j]);
+            }
+        }
+    }
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const auto dt_direct = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    const auto dt_search = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+    std::cout << "Positions: " << positions.size() << std::endl;
+    std::cout << "Checks: " << checks << std::endl;
+    std::cout << "Legal: " << legal_direct << std::endl;
+    std::cout << "Search: " << dt_search / checks << "ns/move" << std::endl;
+    std::cout << "Direct: " << dt_direct / checks << "ns/move" << std::endl;
+
+    if (legal_search != legal_direct) {
+        std::cout << "Mismatch: " << legal_search << " vs " << legal_direct << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
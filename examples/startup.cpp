@@ -0,0 +1,61 @@
+#include <spawn.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <libchess/position.hpp>
+#include <string>
+
+extern char **environ;
+
+// Launches this program repeatedly and times each process from launch until its first legal_moves() returns
+int main(int argc, char **argv) {
+    if (argc > 1 && std::string(argv[1]) == "child") {
+        const auto pos = libchess::Position("startpos");
+        return pos.legal_moves().size() == 20 ? 0 : 1;
+    }
+
+    int runs = 100;
+
+    if (argc > 1) {
+        runs = std::stoi(std::string(argv[1]));
+        runs = std::max(runs, 1);
+    }
+
+    char child[] = "child";
+    char *child_argv[] = {argv[0], child, nullptr};
+    auto best = std::chrono::steady_clock::duration::max();
+    auto total = std::chrono::steady_clock::duration::zero();
+
+    for (int i = 0; i < runs; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+
+        pid_t pid;
+        if (posix_spawn(&pid, argv[0], nullptr, nullptr, child_argv, environ) != 0) {
+            std::cerr << "Failed to launch " << argv[0] << std::endl;
+            return 1;
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "Child process failed" << std::endl;
+            return 1;
+        }
+
+        best = std::min(best, t1 - t0);
+        total += t1 - t0;
+    }
+
+    const auto us = [](const auto d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+
+    std::cout << "Runs: " << runs << std::endl;
+    std::cout << "Best: " << us(best) << "us" << std::endl;
+    std::cout << "Mean: " << us(total / runs) << "us" << std::endl;
+
+    return 0;
+}
@@ -26,7 +26,8 @@ struct TTEntry {
 
     std::uint64_t nodes = 0;
 
-    const auto moves = pos.legal_moves();
+    libchess::MoveList moves;
+    pos.legal_moves(moves);
     for (const auto &move : moves) {
         pos.makemove(move);
         nodes += ttperft(tt, pos, depth - 1);
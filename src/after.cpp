@@ -0,0 +1,15 @@
+#include "libchess/boardstate.hpp"
+
+namespace libchess {
+
+[[nodiscard]] BoardState BoardState::after(const Move &move) const noexcept {
+    auto state = *this;
+    if (turn == Side::White) {
+        state.makemove<Side::White>(move);
+    } else {
+        state.makemove<Side::Black>(move);
+    }
+    return state;
+}
+
+}  // namespace libchess
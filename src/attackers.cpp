@@ -1,31 +1,31 @@
 #include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 [[nodiscard]] Bitboard Position::attackers(const Square sq, const Side s) const noexcept {
+    return s == Side::White ? attackers<Side::White>(sq) : attackers<Side::Black>(sq);
+}
+
+template <Side S>
+[[nodiscard]] Bitboard Position::attackers(const Square sq) const noexcept {
     Bitboard mask;
-    const auto bb = Bitboard{sq};
 
-    if (s == Side::White) {
-        const auto pawns = pieces(s, Piece::Pawn);
-        mask |= pawns & bb.south().east();
-        mask |= pawns & bb.south().west();
-    } else {
-        const auto pawns = pieces(s, Piece::Pawn);
-        mask |= pawns & bb.north().east();
-        mask |= pawns & bb.north().west();
-    }
+    mask |= pieces(S, Piece::Pawn) & pawn_attacks<!S>(Bitboard{sq});
 
-    mask |= movegen::knight_moves(sq) & pieces(s, Piece::Knight);
+    mask |= movegen::knight_moves(sq) & pieces(S, Piece::Knight);
 
-    mask |= movegen::bishop_moves(sq, ~empty()) & (pieces(s, Piece::Bishop) | pieces(s, Piece::Queen));
+    mask |= movegen::bishop_moves(sq, ~empty()) & (pieces(S, Piece::Bishop) | pieces(S, Piece::Queen));
 
-    mask |= movegen::rook_moves(sq, ~empty()) & (pieces(s, Piece::Rook) | pieces(s, Piece::Queen));
+    mask |= movegen::rook_moves(sq, ~empty()) & (pieces(S, Piece::Rook) | pieces(S, Piece::Queen));
 
-    mask |= movegen::king_moves(sq) & pieces(s, Piece::King);
+    mask |= movegen::king_moves(sq) & pieces(S, Piece::King);
 
     return mask;
 }
 
+template Bitboard Position::attackers<Side::White>(const Square sq) const noexcept;
+template Bitboard Position::attackers<Side::Black>(const Square sq) const noexcept;
+
 }  // namespace libchess
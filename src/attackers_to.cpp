@@ -0,0 +1,18 @@
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+// Attackers of both sides given an occupancy, sliders see through anything that isn't in it
+[[nodiscard]] Bitboard Position::attackers_to(const Square sq, const Bitboard occ) const noexcept {
+    const auto bishops = occupancy(Piece::Bishop) | occupancy(Piece::Queen);
+    const auto rooks = occupancy(Piece::Rook) | occupancy(Piece::Queen);
+
+    return (pieces(Side::White, Piece::Pawn) & pawn_attacks<Side::Black>(Bitboard{sq})) |
+           (pieces(Side::Black, Piece::Pawn) & pawn_attacks<Side::White>(Bitboard{sq})) |
+           (movegen::knight_moves(sq) & occupancy(Piece::Knight)) | (movegen::bishop_moves(sq, occ) & bishops) |
+           (movegen::rook_moves(sq, occ) & rooks) | (movegen::king_moves(sq) & occupancy(Piece::King));
+}
+
+}  // namespace libchess
@@ -1,32 +1,166 @@
+#include <cassert>
 #include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 [[nodiscard]] std::vector<Move> Position::check_evasions() const noexcept {
-    std::vector<Move> moves;
-    moves.reserve(8);
+    MoveList moves;
+    check_evasions(moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::check_evasions(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        check_evasions<Side::White>(moves);
+    } else {
+        check_evasions<Side::Black>(moves);
+    }
+}
+
+template <Side Us>
+void Position::check_evasions(MoveList &moves) const noexcept {
+    [[maybe_unused]] const auto start_size = moves.size();
+    constexpr auto them = !Us;
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    constexpr auto double_rank = relative_rank<Us>(3);
+    const auto &ci = check_info();
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
+
+    // King
+    {
+        const auto mask = movegen::king_moves(ksq) & ~ci.king_danger;
+
+        // Captures
+        for (const auto &to : mask & occupancy(them)) {
+            const auto cap = piece_on(to);
+            assert(cap != Piece::None);
+            assert(cap != Piece::King);
+            moves.emplace_back(MoveType::Capture, ksq, to, Piece::King, cap);
+        }
+
+        // Non-captures
+        for (const auto &to : mask & ~occ) {
+            moves.emplace_back(MoveType::Normal, ksq, to, Piece::King);
+        }
+    }
+
+    // If we're in check multiple times, only the king can move
+    // Out of check this keeps the old behaviour of only generating king moves
+    if (ci.checkers.count() != 1) {
+        return;
+    }
+
+    const auto checker = ci.checkers.lsb();
+    const auto captured = piece_on(checker);
+    const auto block = squares_between(ksq, checker);
+
+    assert(captured != Piece::None);
+    assert(captured != Piece::King);
+
+    // A pinned piece can't leave its pin ray, so it can never capture the checker or block
+    const auto movable = occupancy(Us) & ~(ci.pinned_diagonal | ci.pinned_orthogonal);
+
+    const auto add_piece_moves = [&](const Square fr, const Piece piece, const Bitboard mask) {
+        if (mask & checker) {
+            moves.emplace_back(MoveType::Capture, fr, checker, piece, captured);
+        }
+        for (const auto &to : mask & block) {
+            moves.emplace_back(MoveType::Normal, fr, to, piece);
+        }
+    };
+
+    // Pawns -- Capture the checker
+    for (const auto &fr : pawn_attacks<them>(Bitboard{checker}) & pieces(Us, Piece::Pawn) & movable) {
+        if (promo_rank & checker) {
+            moves.emplace_back(MoveType::promo_capture, fr, checker, Piece::Pawn, captured, Piece::Queen);
+            moves.emplace_back(MoveType::promo_capture, fr, checker, Piece::Pawn, captured, Piece::Rook);
+            moves.emplace_back(MoveType::promo_capture, fr, checker, Piece::Pawn, captured, Piece::Bishop);
+            moves.emplace_back(MoveType::promo_capture, fr, checker, Piece::Pawn, captured, Piece::Knight);
+        } else {
+            moves.emplace_back(MoveType::Capture, fr, checker, Piece::Pawn, captured);
+        }
+    }
+
+    // Pawns -- Block
+    if (block) {
+        const auto pawns = pieces(Us, Piece::Pawn) & movable;
+        const auto singles = forward<Us>(pawns) & ~occ;
+        const auto doubles = forward<Us>(singles) & ~occ & double_rank & block;
+
+        for (const auto &to : singles & block) {
+            const auto fr = backward<Us>(to);
+            if (promo_rank & to) {
+                moves.emplace_back(MoveType::promo, fr, to, Piece::Pawn, Piece::None, Piece::Queen);
+                moves.emplace_back(MoveType::promo, fr, to, Piece::Pawn, Piece::None, Piece::Rook);
+                moves.emplace_back(MoveType::promo, fr, to, Piece::Pawn, Piece::None, Piece::Bishop);
+                moves.emplace_back(MoveType::promo, fr, to, Piece::Pawn, Piece::None, Piece::Knight);
+            } else {
+                moves.emplace_back(MoveType::Normal, fr, to, Piece::Pawn);
+            }
+        }
+
+        for (const auto &to : doubles) {
+            moves.emplace_back(MoveType::Double, backward<Us>(backward<Us>(to)), to, Piece::Pawn);
+        }
+    }
+
+    // En passant
+    // Either captures the checking pawn or blocks a slider, then look at the king directly for pins
+    if (state_.ep != squares::OffSq) {
+        const auto ep_bb = Bitboard{state_.ep};
+        const auto cap_bb = backward<Us>(ep_bb);
+
+        if ((cap_bb & checker) || (block & state_.ep)) {
+            const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+            const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
+
+            for (const auto &fr : pawn_attacks<them>(ep_bb) & pieces(Us, Piece::Pawn)) {
+                const auto blockers = (occ ^ Bitboard{fr} ^ cap_bb) | ep_bb;
 
-    const auto ksq = king_position(turn());
-    const auto safe = king_allowed(turn());
-    const auto mask = movegen::king_moves(ksq) & safe;
+                if (movegen::bishop_moves(ksq, blockers) & bishop_attackers) {
+                    continue;
+                }
 
-    // Captures
-    for (const auto &to : occupancy(!turn()) & mask) {
-        const auto cap = piece_on(to);
-        assert(cap != Piece::None);
-        assert(cap != Piece::King);
-        moves.emplace_back(MoveType::Capture, ksq, to, Piece::King, cap);
+                if (movegen::rook_moves(ksq, blockers) & rook_attackers) {
+                    continue;
+                }
+
+                moves.emplace_back(MoveType::enpassant, fr, state_.ep, Piece::Pawn, Piece::Pawn);
+            }
+        }
+    }
+
+    // Knights
+    for (const auto &fr : pieces(Us, Piece::Knight) & movable) {
+        add_piece_moves(fr, Piece::Knight, movegen::knight_moves(fr));
+    }
+
+    // Bishops
+    for (const auto &fr : pieces(Us, Piece::Bishop) & movable) {
+        add_piece_moves(fr, Piece::Bishop, movegen::bishop_moves(fr, occ));
     }
 
-    // Non-captures
-    for (const auto &to : empty() & mask) {
-        moves.emplace_back(MoveType::Normal, ksq, to, Piece::King);
+    // Rooks
+    for (const auto &fr : pieces(Us, Piece::Rook) & movable) {
+        add_piece_moves(fr, Piece::Rook, movegen::rook_moves(fr, occ));
     }
 
-    assert(moves.size() <= 8);
+    // Queens
+    for (const auto &fr : pieces(Us, Piece::Queen) & movable) {
+        add_piece_moves(fr, Piece::Queen, movegen::queen_moves(fr, occ));
+    }
 
-    return moves;
+#ifndef NDEBUG
+    for (std::size_t i = start_size; i < moves.size(); ++i) {
+        assert(is_legal(moves[i]));
+    }
+#endif
 }
 
+template void Position::check_evasions<Side::White>(MoveList &moves) const noexcept;
+template void Position::check_evasions<Side::Black>(MoveList &moves) const noexcept;
+
 }  // namespace libchess
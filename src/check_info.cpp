@@ -0,0 +1,82 @@
+#include <cassert>
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+[[nodiscard]] CheckInfo Position::calculate_check_info() const noexcept {
+    if (turn() == Side::White) {
+        return calculate_check_info<Side::White>();
+    } else {
+        return calculate_check_info<Side::Black>();
+    }
+}
+
+template <Side Us>
+[[nodiscard]] CheckInfo Position::calculate_check_info() const noexcept {
+    constexpr auto them = !Us;
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
+    const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+    const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
+    CheckInfo ci;
+
+    ci.checkers = attackers<them>(ksq);
+
+    // Only the checker and the squares between it and the king can stop a single check
+    if (ci.checkers.empty()) {
+        ci.check_mask = bitboards::AllSquares;
+    } else if (ci.checkers.count() == 1) {
+        ci.check_mask = squares_between(ksq, ci.checkers.lsb()) | ci.checkers;
+    }
+
+    // Pins -- Look for enemy sliders with exactly one of our pieces between them and the king
+    for (const auto &sq : movegen::bishop_moves(ksq, occupancy(them)) & bishop_attackers) {
+        const auto between = squares_between(ksq, sq);
+        const auto blockers = between & occ;
+        if (blockers.count() == 1 && (blockers & occupancy(Us))) {
+            ci.pinned_diagonal |= blockers;
+            ci.pin_diagonal |= between | sq;
+        }
+    }
+
+    for (const auto &sq : movegen::rook_moves(ksq, occupancy(them)) & rook_attackers) {
+        const auto between = squares_between(ksq, sq);
+        const auto blockers = between & occ;
+        if (blockers.count() == 1 && (blockers & occupancy(Us))) {
+            ci.pinned_orthogonal |= blockers;
+            ci.pin_orthogonal |= between | sq;
+        }
+    }
+
+    // King danger
+    {
+        const auto blockers = occ ^ ksq;
+
+        ci.king_danger |= pawn_attacks<them>(pieces(them, Piece::Pawn));
+
+        for (const auto &fr : pieces(them, Piece::Knight)) {
+            ci.king_danger |= movegen::knight_moves(fr);
+        }
+
+        for (const auto &fr : bishop_attackers) {
+            ci.king_danger |= movegen::bishop_moves(fr, blockers);
+        }
+
+        for (const auto &fr : rook_attackers) {
+            ci.king_danger |= movegen::rook_moves(fr, blockers);
+        }
+
+        ci.king_danger |= movegen::king_moves(king_position(them));
+    }
+
+    assert((ci.pinned_diagonal | ci.pinned_orthogonal) == pinned(Us, ksq));
+
+    return ci;
+}
+
+template CheckInfo Position::calculate_check_info<Side::White>() const noexcept;
+template CheckInfo Position::calculate_check_info<Side::Black>() const noexcept;
+
+}  // namespace libchess
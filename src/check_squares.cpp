@@ -0,0 +1,46 @@
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+[[nodiscard]] CheckSquares Position::check_squares() const noexcept {
+    if (turn() == Side::White) {
+        return calculate_check_squares<Side::White>();
+    } else {
+        return calculate_check_squares<Side::Black>();
+    }
+}
+
+template <Side Us>
+[[nodiscard]] CheckSquares Position::calculate_check_squares() const noexcept {
+    constexpr auto them = !Us;
+    const auto ksq = king_position(them);
+    const auto occ = occupied();
+    CheckSquares cs;
+
+    cs.squares[Piece::Pawn] = pawn_attacks<them>(Bitboard{ksq});
+    cs.squares[Piece::Knight] = movegen::knight_moves(ksq);
+    cs.squares[Piece::Bishop] = movegen::bishop_moves(ksq, occ);
+    cs.squares[Piece::Rook] = movegen::rook_moves(ksq, occ);
+    cs.squares[Piece::Queen] = cs.squares[Piece::Bishop] | cs.squares[Piece::Rook];
+
+    // Discovered checks -- The mirror of pins, our sliders with exactly one of our pieces between them and the king
+    const auto bishop_snipers =
+        movegen::bishop_moves(ksq, Bitboard{}) & (pieces(Us, Piece::Bishop) | pieces(Us, Piece::Queen));
+    const auto rook_snipers = movegen::rook_moves(ksq, Bitboard{}) & (pieces(Us, Piece::Rook) | pieces(Us, Piece::Queen));
+
+    for (const auto &sq : bishop_snipers | rook_snipers) {
+        const auto blockers = squares_between(ksq, sq) & occ;
+        if (blockers.count() == 1 && (blockers & occupancy(Us))) {
+            cs.discovered |= blockers;
+        }
+    }
+
+    return cs;
+}
+
+template CheckSquares Position::calculate_check_squares<Side::White>() const noexcept;
+template CheckSquares Position::calculate_check_squares<Side::Black>() const noexcept;
+
+}  // namespace libchess
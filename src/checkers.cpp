@@ -4,7 +4,8 @@
 namespace libchess {
 
 [[nodiscard]] Bitboard Position::checkers() const noexcept {
-    return attackers(king_position(turn()), !turn());
+    // Cheaper than working out the whole check info after makemove_pseudo()
+    return check_info_ ? check_info_->checkers : attackers(king_position(turn()), !turn());
 }
 
 }  // namespace libchess
@@ -1,9 +1,155 @@
+#include <cassert>
+#include "libchess/bitboard.hpp"
+#include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
 
 namespace libchess {
 
+// Counts the legal moves without creating any of them, this mirrors legal_captures() and legal_noncaptures()
 [[nodiscard]] std::size_t Position::count_moves() const noexcept {
-    return legal_moves().size();
+    const auto us = turn();
+    const auto them = !us;
+    const auto &ci = check_info();
+    const auto ksq = king_position(us);
+    const auto occ = occupied();
+    std::size_t count = 0;
+
+    // King
+    count += (movegen::king_moves(ksq) & ~ci.king_danger & ~occupancy(us)).count();
+
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
+        return count;
+    }
+
+    // If we're in check by one piece, we have to capture or block it
+    const auto target = ~occupancy(us) & ci.check_mask;
+    const auto pinned = ci.pinned_diagonal | ci.pinned_orthogonal;
+    const auto promo_rank = us == Side::White ? bitboards::Rank8 : bitboards::Rank1;
+    const auto double_rank = us == Side::White ? bitboards::Rank4 : bitboards::Rank5;
+
+    // Pawns
+    {
+        const auto pawns = pieces(us, Piece::Pawn);
+        const auto push = pawns & ~ci.pinned_diagonal;
+        const auto capture = pawns & ~ci.pinned_orthogonal;
+        const auto push_free = push & ~ci.pinned_orthogonal;
+        const auto push_pinned = push & ci.pinned_orthogonal;
+        const auto capture_free = capture & ~ci.pinned_diagonal;
+        const auto capture_pinned = capture & ci.pinned_diagonal;
+        Bitboard singles;
+        Bitboard doubles;
+        Bitboard left;
+        Bitboard right;
+
+        if (us == Side::White) {
+            singles = (push_free.north() | (push_pinned.north() & ci.pin_orthogonal)) & ~occ;
+            doubles = singles.north() & ~occ & double_rank;
+            left = capture_free.north().west();
+            right = capture_free.north().east();
+            left |= capture_pinned.north().west() & ci.pin_diagonal;
+            right |= capture_pinned.north().east() & ci.pin_diagonal;
+        } else {
+            singles = (push_free.south() | (push_pinned.south() & ci.pin_orthogonal)) & ~occ;
+            doubles = singles.south() & ~occ & double_rank;
+            left = capture_free.south().west();
+            right = capture_free.south().east();
+            left |= capture_pinned.south().west() & ci.pin_diagonal;
+            right |= capture_pinned.south().east() & ci.pin_diagonal;
+        }
+
+        singles &= target;
+        doubles &= target;
+        left &= target & occupancy(them);
+        right &= target & occupancy(them);
+
+        count += (singles & ~promo_rank).count() + 4 * (singles & promo_rank).count() + doubles.count() +
+                 (left & ~promo_rank).count() + 4 * (left & promo_rank).count() + (right & ~promo_rank).count() +
+                 4 * (right & promo_rank).count();
+    }
+
+    // En passant
+    if (state_.ep != squares::OffSq) {
+        const auto ep_bb = Bitboard{state_.ep};
+        const auto cap_bb = us == Side::White ? ep_bb.south() : ep_bb.north();
+        const auto from_bb = us == Side::White ? (ep_bb.south().east() | ep_bb.south().west())
+                                               : (ep_bb.north().east() | ep_bb.north().west());
+        const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+        const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
+
+        // Any checker that isn't a slider has to be the pawn we're capturing
+        if (!(ci.checkers & ~cap_bb & ~bishop_attackers & ~rook_attackers)) {
+            for (const auto &fr : from_bb & pieces(us, Piece::Pawn)) {
+                const auto blockers = (occ ^ Bitboard{fr} ^ cap_bb) | ep_bb;
+
+                if (movegen::bishop_moves(ksq, blockers) & bishop_attackers) {
+                    continue;
+                }
+
+                if (movegen::rook_moves(ksq, blockers) & rook_attackers) {
+                    continue;
+                }
+
+                count++;
+            }
+        }
+    }
+
+    // Knights
+    for (const auto &fr : pieces(us, Piece::Knight) & ~pinned) {
+        count += (movegen::knight_moves(fr) & target).count();
+    }
+
+    // Bishops & Queens
+    for (const auto &fr : (pieces(us, Piece::Bishop) | pieces(us, Piece::Queen)) & ~ci.pinned_orthogonal) {
+        auto mask = movegen::bishop_moves(fr, occ) & target;
+        if (ci.pinned_diagonal & fr) {
+            mask &= ci.pin_diagonal;
+        }
+        count += mask.count();
+    }
+
+    // Rooks & Queens
+    for (const auto &fr : (pieces(us, Piece::Rook) | pieces(us, Piece::Queen)) & ~ci.pinned_diagonal) {
+        auto mask = movegen::rook_moves(fr, occ) & target;
+        if (ci.pinned_orthogonal & fr) {
+            mask &= ci.pin_orthogonal;
+        }
+        count += mask.count();
+    }
+
+    // Castling
+    if (!ci.checkers) {
+        if (us == Side::White) {
+            if (can_castle(Side::White, MoveType::ksc) && !(occ & squares_between(squares::E1, squares::H1)) &&
+                !(ci.king_danger & (Bitboard{squares::F1} | squares::G1))) {
+                count++;
+            }
+            if (can_castle(Side::White, MoveType::qsc) && !(occ & squares_between(squares::E1, squares::A1)) &&
+                !(ci.king_danger & (Bitboard{squares::D1} | squares::C1))) {
+                count++;
+            }
+        } else {
+            if (can_castle(Side::Black, MoveType::ksc) && !(occ & squares_between(squares::E8, squares::H8)) &&
+                !(ci.king_danger & (Bitboard{squares::F8} | squares::G8))) {
+                count++;
+            }
+            if (can_castle(Side::Black, MoveType::qsc) && !(occ & squares_between(squares::E8, squares::A8)) &&
+                !(ci.king_danger & (Bitboard{squares::D8} | squares::C8))) {
+                count++;
+            }
+        }
+    }
+
+#ifndef NDEBUG
+    {
+        MoveList moves;
+        legal_moves(moves);
+        assert(count == moves.size());
+    }
+#endif
+
+    return count;
 }
 
 }  // namespace libchess
@@ -0,0 +1,93 @@
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+[[nodiscard]] bool Position::gives_check(const Move &move) const noexcept {
+    if (turn() == Side::White) {
+        return gives_check<Side::White>(move, check_squares());
+    } else {
+        return gives_check<Side::Black>(move, check_squares());
+    }
+}
+
+[[nodiscard]] bool Position::gives_check(const Move &move, const CheckSquares &cs) const noexcept {
+    if (turn() == Side::White) {
+        return gives_check<Side::White>(move, cs);
+    } else {
+        return gives_check<Side::Black>(move, cs);
+    }
+}
+
+// Assumes the move is legal and the check squares are for this position
+template <Side Us>
+[[nodiscard]] bool Position::gives_check(const Move &move, const CheckSquares &cs) const noexcept {
+    constexpr auto them = !Us;
+    const auto ksq = king_position(them);
+    const auto from = move.from();
+    const auto to = move.to();
+
+    assert(pieces(Us, move.piece()) & from);
+
+    // Direct check
+    if (!move.is_promoting() && (cs.squares[move.piece()] & to)) {
+        return true;
+    }
+
+    // Discovered check
+    if ((cs.discovered & from) && !(squares_line(ksq, from) & to)) {
+        return true;
+    }
+
+    switch (move.type()) {
+        case MoveType::Normal:
+        case MoveType::Capture:
+        case MoveType::Double:
+            return false;
+        case MoveType::promo:
+        case MoveType::promo_capture: {
+            // The pawn leaving may open a line for the new piece
+            const auto occ = occupied() ^ from;
+            switch (move.promotion()) {
+                case Piece::Knight:
+                    return static_cast<bool>(movegen::knight_moves(to) & ksq);
+                case Piece::Bishop:
+                    return static_cast<bool>(movegen::bishop_moves(to, occ) & ksq);
+                case Piece::Rook:
+                    return static_cast<bool>(movegen::rook_moves(to, occ) & ksq);
+                case Piece::Queen:
+                    return static_cast<bool>(movegen::queen_moves(to, occ) & ksq);
+                case Piece::Pawn:
+                case Piece::King:
+                case Piece::None:
+                default:
+                    return false;
+            }
+        }
+        case MoveType::enpassant: {
+            // Removing the captured pawn may open a line too
+            const auto cap = backward<Us>(to);
+            const auto occ = (occupied() ^ from ^ cap) | to;
+            const auto bishops = pieces(Us, Piece::Bishop) | pieces(Us, Piece::Queen);
+            const auto rooks = pieces(Us, Piece::Rook) | pieces(Us, Piece::Queen);
+            return static_cast<bool>((movegen::bishop_moves(ksq, occ) & bishops) |
+                                     (movegen::rook_moves(ksq, occ) & rooks));
+        }
+        case MoveType::ksc: {
+            const auto occ = (occupied() ^ from ^ ksc_rook_fr[Us]) | to | ksc_rook_to[Us];
+            return static_cast<bool>(movegen::rook_moves(ksc_rook_to[Us], occ) & ksq);
+        }
+        case MoveType::qsc: {
+            const auto occ = (occupied() ^ from ^ qsc_rook_fr[Us]) | to | qsc_rook_to[Us];
+            return static_cast<bool>(movegen::rook_moves(qsc_rook_to[Us], occ) & ksq);
+        }
+        default:
+            return false;
+    }
+}
+
+template bool Position::gives_check<Side::White>(const Move &move, const CheckSquares &cs) const noexcept;
+template bool Position::gives_check<Side::Black>(const Move &move, const CheckSquares &cs) const noexcept;
+
+}  // namespace libchess
@@ -0,0 +1,107 @@
+#include <cassert>
+#include "libchess/bitboard.hpp"
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+[[nodiscard]] bool Position::has_legal_move() const noexcept {
+    if (turn() == Side::White) {
+        return has_legal_move<Side::White>();
+    } else {
+        return has_legal_move<Side::Black>();
+    }
+}
+
+// Same masks as the legal move generators, but stops at the first piece with anywhere to go
+// Castling never needs checking, it requires the king to have a legal step towards the rook
+template <Side Us>
+[[nodiscard]] bool Position::has_legal_move() const noexcept {
+    constexpr auto them = !Us;
+    const auto &ci = check_info();
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
+
+    // King
+    if (movegen::king_moves(ksq) & ~occupancy(Us) & ~ci.king_danger) {
+        return true;
+    }
+
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
+        return false;
+    }
+
+    const auto target = ~occupancy(Us) & ci.check_mask;
+    const auto pinned = ci.pinned_diagonal | ci.pinned_orthogonal;
+
+    // Knights
+    for (const auto &fr : pieces(Us, Piece::Knight) & ~pinned) {
+        if (movegen::knight_moves(fr) & target) {
+            return true;
+        }
+    }
+
+    // Bishops and queens along diagonals
+    for (const auto &fr : (pieces(Us, Piece::Bishop) | pieces(Us, Piece::Queen)) & ~ci.pinned_orthogonal) {
+        auto mask = movegen::bishop_moves(fr, occ) & target;
+        if (ci.pinned_diagonal & fr) {
+            mask &= ci.pin_diagonal;
+        }
+        if (mask) {
+            return true;
+        }
+    }
+
+    // Rooks and queens along ranks and files
+    for (const auto &fr : (pieces(Us, Piece::Rook) | pieces(Us, Piece::Queen)) & ~ci.pinned_diagonal) {
+        auto mask = movegen::rook_moves(fr, occ) & target;
+        if (ci.pinned_orthogonal & fr) {
+            mask &= ci.pin_orthogonal;
+        }
+        if (mask) {
+            return true;
+        }
+    }
+
+    // Pawns
+    {
+        const auto pawns = pieces(Us, Piece::Pawn);
+
+        // Pushes -- Pawns pinned along a diagonal can never push
+        const auto pushers = pawns & ~ci.pinned_diagonal;
+        const auto free = pushers & ~ci.pinned_orthogonal;
+        const auto orth = pushers & ci.pinned_orthogonal;
+        const auto singles = (forward<Us>(free) | (forward<Us>(orth) & ci.pin_orthogonal)) & ~occ;
+        const auto doubles = forward<Us>(singles) & ~occ & relative_rank<Us>(3);
+        if ((singles | doubles) & ci.check_mask) {
+            return true;
+        }
+
+        // Captures -- Pawns pinned along a rank or file can never capture
+        const auto capturers = pawns & ~ci.pinned_orthogonal;
+        const auto free_cap = capturers & ~ci.pinned_diagonal;
+        const auto diag = capturers & ci.pinned_diagonal;
+        const auto attacks = pawn_attacks<Us>(free_cap) | (pawn_attacks<Us>(diag) & ci.pin_diagonal);
+        if (attacks & occupancy(them) & ci.check_mask) {
+            return true;
+        }
+    }
+
+    // En passant -- Rare enough to leave to is_legal()
+    if (state_.ep != squares::OffSq) {
+        for (const auto &fr : pawn_attacks<them>(Bitboard{state_.ep}) & pieces(Us, Piece::Pawn)) {
+            if (is_legal<Us>(Move(MoveType::enpassant, fr, state_.ep, Piece::Pawn, Piece::Pawn))) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template bool Position::has_legal_move<Side::White>() const noexcept;
+template bool Position::has_legal_move<Side::Black>() const noexcept;
+
+}  // namespace libchess
@@ -1,14 +1,207 @@
-#include <algorithm>
-#include <ranges>
+#include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 [[nodiscard]] bool Position::is_legal(const Move &m) const noexcept {
-    const auto moves = legal_moves();
-    return std::ranges::any_of(moves, [m](const auto &move) {
-        return move == m;
-    });
+    if (turn() == Side::White) {
+        return is_legal<Side::White>(m);
+    } else {
+        return is_legal<Side::Black>(m);
+    }
 }
 
+// Checks the move directly against the position rather than searching the legal move list,
+// every field of the move has to match so moves from a different position are rejected
+template <Side Us>
+[[nodiscard]] bool Position::is_legal(const Move &m) const noexcept {
+    constexpr auto them = !Us;
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    const auto from = m.from();
+    const auto to = m.to();
+    const auto piece = m.piece();
+    const auto captured = m.captured();
+    const auto promo = m.promotion();
+    const auto occ = occupied();
+
+    if (from == to || piece > Piece::King) {
+        return false;
+    }
+
+    // The piece has to be ours and the destination can't be
+    if (!(pieces(Us, piece) & from) || (occupancy(Us) & to)) {
+        return false;
+    }
+
+    // The move type has to agree with what's on the destination square
+    switch (m.type()) {
+        case MoveType::Normal:
+        case MoveType::Double:
+        case MoveType::ksc:
+        case MoveType::qsc:
+            if (captured != Piece::None || promo != Piece::None || (occ & to)) {
+                return false;
+            }
+            break;
+        case MoveType::Capture:
+            if (captured >= Piece::King || promo != Piece::None || !(pieces(them, captured) & to)) {
+                return false;
+            }
+            break;
+        case MoveType::enpassant:
+            if (piece != Piece::Pawn || captured != Piece::Pawn || promo != Piece::None || to != state_.ep) {
+                return false;
+            }
+            // The pawn being captured has to be there, a state can claim an ep square without one
+            if (!(pieces(them, Piece::Pawn) & backward<Us>(to))) {
+                return false;
+            }
+            break;
+        case MoveType::promo:
+            if (captured != Piece::None || promo < Piece::Knight || promo > Piece::Queen || (occ & to)) {
+                return false;
+            }
+            break;
+        case MoveType::promo_capture:
+            if (captured >= Piece::King || promo < Piece::Knight || promo > Piece::Queen ||
+                !(pieces(them, captured) & to)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    const auto &ci = check_info();
+    const auto ksq = king_position(Us);
+
+    // The piece has to be able to get there
+    switch (piece) {
+        case Piece::Pawn: {
+            if (m.is_promoting() != static_cast<bool>(promo_rank & to)) {
+                return false;
+            }
+
+            switch (m.type()) {
+                case MoveType::Normal:
+                case MoveType::promo:
+                    if (forward<Us>(from) != to) {
+                        return false;
+                    }
+                    break;
+                case MoveType::Double:
+                    if (!(relative_rank<Us>(1) & from) || (occ & forward<Us>(from)) ||
+                        forward<Us>(forward<Us>(from)) != to) {
+                        return false;
+                    }
+                    break;
+                case MoveType::Capture:
+                case MoveType::promo_capture:
+                case MoveType::enpassant:
+                    if (!(pawn_attacks<Us>(Bitboard{from}) & to)) {
+                        return false;
+                    }
+                    break;
+                case MoveType::ksc:
+                case MoveType::qsc:
+                default:
+                    return false;
+            }
+            break;
+        }
+        case Piece::Knight:
+            if (m.type() != MoveType::Normal && m.type() != MoveType::Capture) {
+                return false;
+            }
+            if (!(movegen::knight_moves(from) & to)) {
+                return false;
+            }
+            break;
+        case Piece::Bishop:
+            if (m.type() != MoveType::Normal && m.type() != MoveType::Capture) {
+                return false;
+            }
+            if (!(movegen::bishop_moves(from, occ) & to)) {
+                return false;
+            }
+            break;
+        case Piece::Rook:
+            if (m.type() != MoveType::Normal && m.type() != MoveType::Capture) {
+                return false;
+            }
+            if (!(movegen::rook_moves(from, occ) & to)) {
+                return false;
+            }
+            break;
+        case Piece::Queen:
+            if (m.type() != MoveType::Normal && m.type() != MoveType::Capture) {
+                return false;
+            }
+            if (!(movegen::queen_moves(from, occ) & to)) {
+                return false;
+            }
+            break;
+        case Piece::King: {
+            constexpr auto ksq_start = relative_square<Us>(squares::E1);
+
+            if (m.type() == MoveType::Normal || m.type() == MoveType::Capture) {
+                return (movegen::king_moves(from) & to) && !(ci.king_danger & to);
+            } else if (m.type() == MoveType::ksc) {
+                constexpr auto king_to = relative_square<Us>(squares::G1);
+                constexpr auto path = squares_between(ksq_start, ksc_rook_fr[Us]);
+                constexpr auto safe = Bitboard{ksc_rook_to[Us]} | king_to;
+                return can_castle(Us, MoveType::ksc) && from == ksq_start && to == king_to && !ci.checkers &&
+                       (pieces(Us, Piece::Rook) & ksc_rook_fr[Us]) && !(occ & path) && !(ci.king_danger & safe);
+            } else if (m.type() == MoveType::qsc) {
+                constexpr auto king_to = relative_square<Us>(squares::C1);
+                constexpr auto path = squares_between(ksq_start, qsc_rook_fr[Us]);
+                constexpr auto safe = Bitboard{qsc_rook_to[Us]} | king_to;
+                return can_castle(Us, MoveType::qsc) && from == ksq_start && to == king_to && !ci.checkers &&
+                       (pieces(Us, Piece::Rook) & qsc_rook_fr[Us]) && !(occ & path) && !(ci.king_danger & safe);
+            }
+            return false;
+        }
+        case Piece::None:
+        default:
+            return false;
+    }
+
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
+        return false;
+    }
+
+    // En passant removes two pieces from the board, so look at the king directly
+    if (m.type() == MoveType::enpassant) {
+        const auto cap_bb = backward<Us>(Bitboard{to});
+        const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+        const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
+        const auto blockers = (occ ^ from ^ cap_bb) | to;
+
+        // Any checker that isn't a slider has to be the pawn we're capturing
+        if (ci.checkers & ~cap_bb & ~bishop_attackers & ~rook_attackers) {
+            return false;
+        }
+
+        return !(movegen::bishop_moves(ksq, blockers) & bishop_attackers) &&
+               !(movegen::rook_moves(ksq, blockers) & rook_attackers);
+    }
+
+    // Deal with any check
+    if (!(ci.check_mask & to)) {
+        return false;
+    }
+
+    // Pinned pieces have to stay between the king and the pinner
+    if (((ci.pinned_diagonal | ci.pinned_orthogonal) & from) && !(squares_line(ksq, from) & to)) {
+        return false;
+    }
+
+    return true;
+}
+
+template bool Position::is_legal<Side::White>(const Move &m) const noexcept;
+template bool Position::is_legal<Side::Black>(const Move &m) const noexcept;
+
 }  // namespace libchess
@@ -0,0 +1,71 @@
+#include <cassert>
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+[[nodiscard]] bool Position::is_pseudo_legal_move_legal(const Move &move) const noexcept {
+    if (turn() == Side::White) {
+        return is_pseudo_legal_move_legal<Side::White>(move);
+    } else {
+        return is_pseudo_legal_move_legal<Side::Black>(move);
+    }
+}
+
+// Assumes the move came from pseudo_legal_moves(), so only king safety is left to check
+// Rather than computing pins, look at the king once with the move applied to the occupancy
+template <Side Us>
+[[nodiscard]] bool Position::is_pseudo_legal_move_legal(const Move &move) const noexcept {
+    constexpr auto them = !Us;
+    const auto from = move.from();
+    const auto to = move.to();
+    const auto occ = occupied();
+    const auto bishops = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+    const auto rooks = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
+
+    assert(pieces(Us, move.piece()) & from);
+
+    // Is the square attacked given the occupancy, ignoring anything on the captured square
+    const auto attacked = [&](const Square sq, const Bitboard blockers, const Bitboard captured) {
+        return static_cast<bool>((pawn_attacks<Us>(Bitboard{sq}) & pieces(them, Piece::Pawn) & ~captured) |
+                                 (movegen::knight_moves(sq) & pieces(them, Piece::Knight) & ~captured) |
+                                 (movegen::bishop_moves(sq, blockers) & bishops & ~captured) |
+                                 (movegen::rook_moves(sq, blockers) & rooks & ~captured) |
+                                 (movegen::king_moves(sq) & pieces(them, Piece::King)));
+    };
+
+    switch (move.type()) {
+        case MoveType::ksc:
+        case MoveType::qsc: {
+            // The king can't castle out of, through, or into check
+            const auto path = squares_between(from, to) | from | to;
+            for (const auto &sq : path) {
+                if (attacked(sq, occ, Bitboard{})) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case MoveType::enpassant: {
+            const auto cap_bb = backward<Us>(Bitboard{to});
+            const auto blockers = (occ ^ from ^ cap_bb) | to;
+            return !attacked(king_position(Us), blockers, cap_bb);
+        }
+        case MoveType::Normal:
+        case MoveType::Double:
+        case MoveType::Capture:
+        case MoveType::promo:
+        case MoveType::promo_capture:
+        default: {
+            const auto ksq = move.piece() == Piece::King ? to : king_position(Us);
+            const auto blockers = (occ ^ from) | to;
+            return !attacked(ksq, blockers, Bitboard{to});
+        }
+    }
+}
+
+template bool Position::is_pseudo_legal_move_legal<Side::White>(const Move &move) const noexcept;
+template bool Position::is_pseudo_legal_move_legal<Side::Black>(const Move &move) const noexcept;
+
+}  // namespace libchess
@@ -1,57 +1,58 @@
 #include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 [[nodiscard]] Bitboard Position::king_allowed() const noexcept {
-    return king_allowed(turn());
+    return ~(check_info().king_danger | occupancy(turn()) | king_position(!turn()));
 }
 
 [[nodiscard]] Bitboard Position::king_allowed(const Side s) const noexcept {
-    const Bitboard blockers = ~empty() ^ king_position(s);
+    return s == Side::White ? king_allowed<Side::White>() : king_allowed<Side::Black>();
+}
+
+template <Side S>
+[[nodiscard]] Bitboard Position::king_allowed() const noexcept {
+    const Bitboard blockers = ~empty() ^ king_position(S);
     Bitboard mask;
 
     // Pawns
-    if (s == Side::White) {
-        const auto pawns = pieces(!s, Piece::Pawn);
-        mask |= pawns.south().east();
-        mask |= pawns.south().west();
-    } else {
-        const auto pawns = pieces(!s, Piece::Pawn);
-        mask |= pawns.north().east();
-        mask |= pawns.north().west();
-    }
+    mask |= pawn_attacks<!S>(pieces(!S, Piece::Pawn));
 
     // Knights
-    for (const auto &fr : pieces(!s, Piece::Knight)) {
+    for (const auto &fr : pieces(!S, Piece::Knight)) {
         mask |= movegen::knight_moves(fr);
     }
 
     // Bishops
-    for (const auto &fr : pieces(!s, Piece::Bishop)) {
+    for (const auto &fr : pieces(!S, Piece::Bishop)) {
         mask |= movegen::bishop_moves(fr, blockers);
     }
 
     // Rooks
-    for (const auto &fr : pieces(!s, Piece::Rook)) {
+    for (const auto &fr : pieces(!S, Piece::Rook)) {
         mask |= movegen::rook_moves(fr, blockers);
     }
 
     // Queens
-    for (const auto &fr : pieces(!s, Piece::Queen)) {
+    for (const auto &fr : pieces(!S, Piece::Queen)) {
         mask |= movegen::queen_moves(fr, blockers);
     }
 
     // King
-    mask |= movegen::king_moves(king_position(!s));
+    mask |= movegen::king_moves(king_position(!S));
 
     // Let's remove friendly pieces
-    mask |= occupancy(s);
+    mask |= occupancy(S);
 
     // Let's remove enemy king square
-    mask |= king_position(!s);
+    mask |= king_position(!S);
 
     return ~mask;
 }
 
+template Bitboard Position::king_allowed<Side::White>() const noexcept;
+template Bitboard Position::king_allowed<Side::Black>() const noexcept;
+
 }  // namespace libchess
@@ -2,157 +2,139 @@
 #include "libchess/bitboard.hpp"
 #include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 #include "libchess/square.hpp"
 
 namespace libchess {
 
 [[nodiscard]] std::vector<Move> Position::legal_captures() const noexcept {
-    std::vector<Move> moves;
-    moves.reserve(50);
+    MoveList moves;
     legal_captures(moves);
-    return moves;
+    return std::vector<Move>(moves.begin(), moves.end());
 }
 
 void Position::legal_captures(std::vector<Move> &moves) const noexcept {
+    MoveList list;
+    legal_captures(list);
+    moves.insert(moves.end(), list.begin(), list.end());
+}
+
+void Position::legal_captures(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        legal_captures<Side::White>(moves);
+    } else {
+        legal_captures<Side::Black>(moves);
+    }
+}
+
+// Only moves from a square in from_mask to a square in to_mask are generated
+template <Side Us>
+void Position::legal_captures(MoveList &moves, const Bitboard from_mask, const Bitboard to_mask) const noexcept {
     [[maybe_unused]] const auto start_size = moves.size();
-    const auto us = turn();
-    const auto them = !us;
-    const auto ksq = king_position(us);
-    const auto checkers = this->checkers();
-    const auto ep_bb = ep_ == squares::OffSq ? Bitboard{} : Bitboard{ep_};
-    auto allowed = occupancy(them);
+    constexpr auto them = !Us;
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    const auto &ci = check_info();
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
 
-    if (checkers.count() > 1) {
-        const auto mask = movegen::king_moves(ksq) & king_allowed() & occupancy(them);
+    // King
+    if (from_mask & ksq) {
+        const auto mask = movegen::king_moves(ksq) & ~ci.king_danger & occupancy(them) & to_mask;
         for (const auto &to : mask) {
             const auto cap = piece_on(to);
             assert(cap != Piece::None);
             assert(cap != Piece::King);
             moves.emplace_back(MoveType::Capture, ksq, to, Piece::King, cap);
         }
+    }
+
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
         return;
-    } else if (checkers.count() == 1) {
-        allowed = Bitboard{checkers.lsb()};
     }
 
-    const auto kfile = bitboards::files[ksq.file()];
-    const auto krank = bitboards::ranks[ksq.rank()];
-    const auto pinned = this->pinned();
-    const auto pinned_horizontal = pinned & krank;
-    const auto pinned_vertical = pinned & kfile;
-    const auto pinned_rook = pinned_horizontal | pinned_vertical;
-    const auto pinned_bishop = pinned ^ pinned_rook;
+    const auto target = occupancy(them) & ci.check_mask & to_mask;
+    const auto pinned = ci.pinned_diagonal | ci.pinned_orthogonal;
 
     // Pawns
-    if (us == Side::White) {
-        const auto pawns = pieces(us, Piece::Pawn) & ~pinned_rook;
-        const auto promo = pawns & bitboards::Rank7;
-        const auto nonpromo = pawns & ~bitboards::Rank7;
+    {
+        // Pawns pinned along a rank or file can never capture
+        const auto pawns = pieces(Us, Piece::Pawn) & ~ci.pinned_orthogonal & from_mask;
+        const auto free = pawns & ~ci.pinned_diagonal;
+        const auto diag = pawns & ci.pinned_diagonal;
+        const auto right = (forward<Us>(free).east() | (forward<Us>(diag).east() & ci.pin_diagonal)) & target;
+        const auto left = (forward<Us>(free).west() | (forward<Us>(diag).west() & ci.pin_diagonal)) & target;
 
         // Captures -- Right
-        for (const auto &sq : nonpromo.north().east() & allowed) {
+        for (const auto &sq : right & ~promo_rank) {
             const auto cap = piece_on(sq);
             assert(cap != Piece::None);
             assert(cap != Piece::King);
-            moves.emplace_back(MoveType::Capture, sq.south().west(), sq, Piece::Pawn, cap);
+            moves.emplace_back(MoveType::Capture, backward<Us>(sq).west(), sq, Piece::Pawn, cap);
         }
 
         // Captures -- left
-        for (const auto &sq : nonpromo.north().west() & allowed) {
+        for (const auto &sq : left & ~promo_rank) {
             const auto cap = piece_on(sq);
             assert(cap != Piece::None);
             assert(cap != Piece::King);
-            moves.emplace_back(MoveType::Capture, sq.south().east(), sq, Piece::Pawn, cap);
+            moves.emplace_back(MoveType::Capture, backward<Us>(sq).east(), sq, Piece::Pawn, cap);
         }
 
         // Promo Captures -- Right
-        for (const auto &sq : promo.north().east() & allowed) {
+        for (const auto &sq : right & promo_rank) {
             const auto cap = piece_on(sq);
+            const auto fr = backward<Us>(sq).west();
             assert(cap != Piece::None);
             assert(cap != Piece::King);
-            moves.emplace_back(MoveType::promo_capture, sq.south().west(), sq, Piece::Pawn, cap, Piece::Queen);
-            moves.emplace_back(MoveType::promo_capture, sq.south().west(), sq, Piece::Pawn, cap, Piece::Rook);
-            moves.emplace_back(MoveType::promo_capture, sq.south().west(), sq, Piece::Pawn, cap, Piece::Bishop);
-            moves.emplace_back(MoveType::promo_capture, sq.south().west(), sq, Piece::Pawn, cap, Piece::Knight);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Queen);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Rook);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Bishop);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Knight);
         }
 
         // Promo Captures -- left
-        for (const auto &sq : promo.north().west() & allowed) {
+        for (const auto &sq : left & promo_rank) {
             const auto cap = piece_on(sq);
+            const auto fr = backward<Us>(sq).east();
             assert(cap != Piece::None);
             assert(cap != Piece::King);
-            moves.emplace_back(MoveType::promo_capture, sq.south().east(), sq, Piece::Pawn, cap, Piece::Queen);
-            moves.emplace_back(MoveType::promo_capture, sq.south().east(), sq, Piece::Pawn, cap, Piece::Rook);
-            moves.emplace_back(MoveType::promo_capture, sq.south().east(), sq, Piece::Pawn, cap, Piece::Bishop);
-            moves.emplace_back(MoveType::promo_capture, sq.south().east(), sq, Piece::Pawn, cap, Piece::Knight);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Queen);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Rook);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Bishop);
+            moves.emplace_back(MoveType::promo_capture, fr, sq, Piece::Pawn, cap, Piece::Knight);
         }
+    }
 
-        // En passant
-        if (ep_ != squares::OffSq) {
-            if (pawns.north().west() & ep_bb) {
-                moves.emplace_back(MoveType::enpassant, ep_.south().east(), ep_, Piece::Pawn, Piece::Pawn);
-            }
-            if (pawns.north().east() & ep_bb) {
-                moves.emplace_back(MoveType::enpassant, ep_.south().west(), ep_, Piece::Pawn, Piece::Pawn);
-            }
-        }
-    } else {
-        const auto pawns = pieces(us, Piece::Pawn) & ~pinned_rook;
-        const auto promo = pawns & bitboards::Rank2;
-        const auto nonpromo = pawns & ~bitboards::Rank2;
+    // En passant
+    // Two pieces leave the same rank at once, so check the king directly rather than trust the pin masks
+    if (state_.ep != squares::OffSq && (to_mask & state_.ep)) {
+        const auto ep_bb = Bitboard{state_.ep};
+        const auto cap_bb = backward<Us>(ep_bb);
+        const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
+        const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
 
-        // Captures -- Right
-        for (const auto &sq : nonpromo.south().east() & allowed) {
-            const auto cap = piece_on(sq);
-            assert(cap != Piece::None);
-            assert(cap != Piece::King);
-            moves.emplace_back(MoveType::Capture, sq.north().west(), sq, Piece::Pawn, cap);
-        }
+        // Any checker that isn't a slider has to be the pawn we're capturing
+        if (!(ci.checkers & ~cap_bb & ~bishop_attackers & ~rook_attackers)) {
+            for (const auto &fr : pawn_attacks<them>(ep_bb) & pieces(Us, Piece::Pawn) & from_mask) {
+                const auto blockers = (occ ^ Bitboard{fr} ^ cap_bb) | ep_bb;
 
-        // Captures -- left
-        for (const auto &sq : nonpromo.south().west() & allowed) {
-            const auto cap = piece_on(sq);
-            assert(cap != Piece::None);
-            assert(cap != Piece::King);
-            moves.emplace_back(MoveType::Capture, sq.north().east(), sq, Piece::Pawn, cap);
-        }
+                if (movegen::bishop_moves(ksq, blockers) & bishop_attackers) {
+                    continue;
+                }
 
-        // Promo Captures -- Right
-        for (const auto &sq : promo.south().east() & allowed) {
-            const auto cap = piece_on(sq);
-            assert(cap != Piece::None);
-            assert(cap != Piece::King);
-            moves.emplace_back(MoveType::promo_capture, sq.north().west(), sq, Piece::Pawn, cap, Piece::Queen);
-            moves.emplace_back(MoveType::promo_capture, sq.north().west(), sq, Piece::Pawn, cap, Piece::Rook);
-            moves.emplace_back(MoveType::promo_capture, sq.north().west(), sq, Piece::Pawn, cap, Piece::Bishop);
-            moves.emplace_back(MoveType::promo_capture, sq.north().west(), sq, Piece::Pawn, cap, Piece::Knight);
-        }
+                if (movegen::rook_moves(ksq, blockers) & rook_attackers) {
+                    continue;
+                }
 
-        // Promo Captures -- left
-        for (const auto &sq : promo.south().west() & allowed) {
-            const auto cap = piece_on(sq);
-            assert(cap != Piece::None);
-            assert(cap != Piece::King);
-            moves.emplace_back(MoveType::promo_capture, sq.north().east(), sq, Piece::Pawn, cap, Piece::Queen);
-            moves.emplace_back(MoveType::promo_capture, sq.north().east(), sq, Piece::Pawn, cap, Piece::Rook);
-            moves.emplace_back(MoveType::promo_capture, sq.north().east(), sq, Piece::Pawn, cap, Piece::Bishop);
-            moves.emplace_back(MoveType::promo_capture, sq.north().east(), sq, Piece::Pawn, cap, Piece::Knight);
-        }
-
-        // En passant
-        if (ep_ != squares::OffSq) {
-            if (pawns.south().west() & ep_bb) {
-                moves.emplace_back(MoveType::enpassant, ep_.north().east(), ep_, Piece::Pawn, Piece::Pawn);
-            }
-            if (pawns.south().east() & ep_bb) {
-                moves.emplace_back(MoveType::enpassant, ep_.north().west(), ep_, Piece::Pawn, Piece::Pawn);
+                moves.emplace_back(MoveType::enpassant, fr, state_.ep, Piece::Pawn, Piece::Pawn);
             }
         }
     }
 
     // Knights
-    for (const auto &fr : pieces(us, Piece::Knight) & ~pinned) {
-        const auto mask = movegen::knight_moves(fr) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Knight) & ~pinned & from_mask) {
+        const auto mask = movegen::knight_moves(fr) & target;
         for (const auto &to : mask) {
             const auto cap = piece_on(to);
             assert(cap != Piece::None);
@@ -162,8 +144,11 @@ void Position::legal_captures(std::vector<Move> &moves) const noexcept {
     }
 
     // Bishops
-    for (const auto &fr : pieces(us, Piece::Bishop) & ~pinned_rook) {
-        const auto mask = movegen::bishop_moves(fr, ~empty()) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Bishop) & ~ci.pinned_orthogonal & from_mask) {
+        auto mask = movegen::bishop_moves(fr, occ) & target;
+        if (ci.pinned_diagonal & fr) {
+            mask &= ci.pin_diagonal;
+        }
         for (const auto &to : mask) {
             const auto cap = piece_on(to);
             assert(cap != Piece::None);
@@ -173,8 +158,11 @@ void Position::legal_captures(std::vector<Move> &moves) const noexcept {
     }
 
     // Rooks
-    for (const auto &fr : pieces(us, Piece::Rook) & ~pinned_bishop) {
-        const auto mask = movegen::rook_moves(fr, ~empty()) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Rook) & ~ci.pinned_diagonal & from_mask) {
+        auto mask = movegen::rook_moves(fr, occ) & target;
+        if (ci.pinned_orthogonal & fr) {
+            mask &= ci.pin_orthogonal;
+        }
         for (const auto &to : mask) {
             const auto cap = piece_on(to);
             assert(cap != Piece::None);
@@ -184,9 +172,16 @@ void Position::legal_captures(std::vector<Move> &moves) const noexcept {
     }
 
     // Queens
-    for (const auto &fr : pieces(us, Piece::Queen)) {
-        const auto mask = movegen::queen_moves(fr, ~empty()) & allowed;
-        for (const auto &to : mask) {
+    for (const auto &fr : pieces(Us, Piece::Queen) & from_mask) {
+        Bitboard mask;
+        if (ci.pinned_diagonal & fr) {
+            mask = movegen::bishop_moves(fr, occ) & ci.pin_diagonal;
+        } else if (ci.pinned_orthogonal & fr) {
+            mask = movegen::rook_moves(fr, occ) & ci.pin_orthogonal;
+        } else {
+            mask = movegen::queen_moves(fr, occ);
+        }
+        for (const auto &to : mask & target) {
             const auto cap = piece_on(to);
             assert(cap != Piece::None);
             assert(cap != Piece::King);
@@ -194,66 +189,6 @@ void Position::legal_captures(std::vector<Move> &moves) const noexcept {
         }
     }
 
-    // King
-    {
-        const auto mask = movegen::king_moves(ksq) & king_allowed() & occupancy(them);
-        for (const auto &to : mask) {
-            const auto cap = piece_on(to);
-            assert(cap != Piece::None);
-            assert(cap != Piece::King);
-            moves.emplace_back(MoveType::Capture, ksq, to, Piece::King, cap);
-        }
-    }
-
-    // Filter pseudolegal moves
-    const auto pawn_attackers = pieces(them, Piece::Pawn);
-    const auto knight_attackers = pieces(them, Piece::Knight);
-    const auto bishop_attackers = pieces(them, Piece::Bishop) | pieces(them, Piece::Queen);
-    const auto rook_attackers = pieces(them, Piece::Rook) | pieces(them, Piece::Queen);
-
-    const auto trash = us == Side::White ? ep_bb.south() : ep_bb.north();
-    // const auto pinned = in_check ? bitboards::AllSquares : this->pinned();
-
-    std::size_t back = start_size;
-    for (std::size_t i = start_size; i < moves.size(); ++i) {
-        const auto bb_from = Bitboard{moves[i].from()};
-        auto legal = true;
-
-        if (moves[i].piece() != Piece::Knight && ((bb_from & pinned) || moves[i].type() == MoveType::enpassant)) {
-            const auto nksq = moves[i].piece() == Piece::King ? moves[i].to() : ksq;
-            auto blockers = (Bitboard{moves[i].from()} ^ occupied()) | Bitboard{moves[i].to()};
-            auto new_pawns = pawn_attackers & ~Bitboard{moves[i].to()};
-
-            if (moves[i].type() == MoveType::enpassant) {
-                blockers ^= trash;
-                new_pawns ^= trash;
-            }
-
-            const auto pawn_attacked =
-                Bitboard{nksq} & (us == Side::White ? new_pawns.south().east() | new_pawns.south().west()
-                                                    : new_pawns.north().east() | new_pawns.north().west());
-
-            if (pawn_attacked) {
-                legal = false;
-            } else if (movegen::knight_moves(nksq) & knight_attackers & ~Bitboard{moves[i].to()}) {
-                legal = false;
-            } else if (movegen::bishop_moves(nksq, blockers) & bishop_attackers & ~Bitboard{moves[i].to()}) {
-                legal = false;
-            } else if (movegen::rook_moves(nksq, blockers) & rook_attackers & ~Bitboard{moves[i].to()}) {
-                legal = false;
-            }
-        }
-
-        if (legal) {
-            if (i > back) {
-                moves[back] = moves[i];
-            }
-            back++;
-        }
-    }
-
-    moves.resize(back);
-
 #ifndef NDEBUG
     for (std::size_t i = start_size; i < moves.size(); ++i) {
         assert(moves[i].is_capturing());
@@ -263,4 +198,11 @@ void Position::legal_captures(std::vector<Move> &moves) const noexcept {
 #endif
 }
 
+template void Position::legal_captures<Side::White>(MoveList &moves,
+                                                   const Bitboard from_mask,
+                                                   const Bitboard to_mask) const noexcept;
+template void Position::legal_captures<Side::Black>(MoveList &moves,
+                                                   const Bitboard from_mask,
+                                                   const Bitboard to_mask) const noexcept;
+
 }  // namespace libchess
@@ -3,11 +3,27 @@
 namespace libchess {
 
 [[nodiscard]] std::vector<Move> Position::legal_moves() const noexcept {
-    std::vector<Move> moves;
-    moves.reserve(200);
-    legal_captures(moves);
-    legal_noncaptures(moves);
-    return moves;
+    MoveList moves;
+    legal_moves(moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::legal_moves(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        if (check_info().checkers) {
+            check_evasions<Side::White>(moves);
+        } else {
+            legal_captures<Side::White>(moves);
+            legal_noncaptures<Side::White>(moves);
+        }
+    } else {
+        if (check_info().checkers) {
+            check_evasions<Side::Black>(moves);
+        } else {
+            legal_captures<Side::Black>(moves);
+            legal_noncaptures<Side::Black>(moves);
+        }
+    }
 }
 
 }  // namespace libchess
@@ -0,0 +1,21 @@
+#include "libchess/position.hpp"
+
+namespace libchess {
+
+[[nodiscard]] std::vector<Move> Position::legal_moves_from(const Square sq) const noexcept {
+    MoveList moves;
+    legal_moves_from(moves, sq);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::legal_moves_from(MoveList &moves, const Square sq) const noexcept {
+    if (turn() == Side::White) {
+        legal_captures<Side::White>(moves, Bitboard{sq}, bitboards::AllSquares);
+        legal_noncaptures<Side::White>(moves, Bitboard{sq}, bitboards::AllSquares);
+    } else {
+        legal_captures<Side::Black>(moves, Bitboard{sq}, bitboards::AllSquares);
+        legal_noncaptures<Side::Black>(moves, Bitboard{sq}, bitboards::AllSquares);
+    }
+}
+
+}  // namespace libchess
@@ -0,0 +1,26 @@
+#include "libchess/position.hpp"
+
+namespace libchess {
+
+[[nodiscard]] std::vector<Move> Position::legal_moves_of(const Piece piece) const noexcept {
+    MoveList moves;
+    legal_moves_of(moves, piece);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::legal_moves_of(MoveList &moves, const Piece piece) const noexcept {
+    // Piece::None has no bitboard
+    if (piece < Piece::Pawn || piece > Piece::King) {
+        return;
+    }
+
+    if (turn() == Side::White) {
+        legal_captures<Side::White>(moves, pieces(Side::White, piece), bitboards::AllSquares);
+        legal_noncaptures<Side::White>(moves, pieces(Side::White, piece), bitboards::AllSquares);
+    } else {
+        legal_captures<Side::Black>(moves, pieces(Side::Black, piece), bitboards::AllSquares);
+        legal_noncaptures<Side::Black>(moves, pieces(Side::Black, piece), bitboards::AllSquares);
+    }
+}
+
+}  // namespace libchess
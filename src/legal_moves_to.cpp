@@ -0,0 +1,21 @@
+#include "libchess/position.hpp"
+
+namespace libchess {
+
+[[nodiscard]] std::vector<Move> Position::legal_moves_to(const Square sq) const noexcept {
+    MoveList moves;
+    legal_moves_to(moves, sq);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::legal_moves_to(MoveList &moves, const Square sq) const noexcept {
+    if (turn() == Side::White) {
+        legal_captures<Side::White>(moves, bitboards::AllSquares, Bitboard{sq});
+        legal_noncaptures<Side::White>(moves, bitboards::AllSquares, Bitboard{sq});
+    } else {
+        legal_captures<Side::Black>(moves, bitboards::AllSquares, Bitboard{sq});
+        legal_noncaptures<Side::Black>(moves, bitboards::AllSquares, Bitboard{sq});
+    }
+}
+
+}  // namespace libchess
@@ -2,229 +2,148 @@
 #include "libchess/bitboard.hpp"
 #include "libchess/movegen.hpp"
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 #include "libchess/square.hpp"
 
 namespace libchess {
 
 [[nodiscard]] std::vector<Move> Position::legal_noncaptures() const noexcept {
-    std::vector<Move> moves;
-    moves.reserve(50);
+    MoveList moves;
     legal_noncaptures(moves);
-    return moves;
+    return std::vector<Move>(moves.begin(), moves.end());
 }
 
 void Position::legal_noncaptures(std::vector<Move> &moves) const noexcept {
-    [[maybe_unused]] const auto start_size = moves.size();
-    const auto us = turn();
-    const auto them = !us;
-    const auto ch = checkers();
-    const auto checked = !ch.empty();
-    const auto ksq = king_position(us);
-    [[maybe_unused]] const auto kfile = bitboards::files[ksq.file()];
-    const auto krank = bitboards::ranks[ksq.rank()];
-
-    // If we're in check multiple times, only the king can move
-    if (ch.count() > 1) {
-        for (const auto &fr : pieces(us, Piece::King)) {
-            const auto mask = movegen::king_moves(fr) & king_allowed();
-            for (const auto &to : empty() & mask) {
-                moves.emplace_back(MoveType::Normal, fr, to, Piece::King);
-            }
-        }
-        return;
-    }
-
-    auto allowed = empty();
-
-    // If we're in check by one piece, we can try block or move the king
-    if (ch.count() == 1) {
-        const auto sq = ch.lsb();
-        assert(piece_on(sq) != Piece::None);
-        assert(piece_on(sq) != Piece::King);
+    MoveList list;
+    legal_noncaptures(list);
+    moves.insert(moves.end(), list.begin(), list.end());
+}
 
-        allowed = squares_between(ksq, sq);
+void Position::legal_noncaptures(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        legal_noncaptures<Side::White>(moves);
+    } else {
+        legal_noncaptures<Side::Black>(moves);
     }
+}
 
-    const Bitboard bishop_rays = movegen::bishop_moves(ksq, occupied());
-    const Bitboard rook_rays = movegen::rook_moves(ksq, occupied());
-
-    Bitboard bishop_pinned;
-    Bitboard rook_pinned;
+// Only moves from a square in from_mask to a square in to_mask are generated
+template <Side Us>
+void Position::legal_noncaptures(MoveList &moves, const Bitboard from_mask, const Bitboard to_mask) const noexcept {
+    [[maybe_unused]] const auto start_size = moves.size();
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    constexpr auto double_rank = relative_rank<Us>(3);
+    const auto &ci = check_info();
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
 
-    // Bishop pinned
-    {
-        for (const auto &sq : occupancy(us) & bishop_rays) {
-            const auto bb = Bitboard{sq};
-            const auto blockers = occupied() ^ bb;
-            const auto new_rays = movegen::bishop_moves(ksq, blockers);
-            const auto discovery = new_rays ^ bishop_rays;
-            const auto attackers = discovery & (pieces(them, Piece::Bishop) | pieces(them, Piece::Queen));
-
-            if (attackers) {
-                bishop_pinned |= bb;
-                const auto asq = attackers.lsb();
-                const auto move_mask = (squares_between(ksq, asq) ^ bb) & allowed;
-
-                if (bb & pieces(us, Piece::Bishop)) {
-                    for (const auto &to : move_mask) {
-                        moves.emplace_back(MoveType::Normal, sq, to, Piece::Bishop);
-                    }
-                } else if (bb & pieces(us, Piece::Queen)) {
-                    for (const auto &to : move_mask) {
-                        moves.emplace_back(MoveType::Normal, sq, to, Piece::Queen);
-                    }
-                }
-            }
+    // King
+    if (from_mask & ksq) {
+        const auto mask = movegen::king_moves(ksq) & ~ci.king_danger & ~occ & to_mask;
+        for (const auto &to : mask) {
+            moves.emplace_back(MoveType::Normal, ksq, to, Piece::King);
         }
     }
 
-    // Rook pinned
-    {
-        for (const auto &sq : occupancy(us) & rook_rays) {
-            const auto bb = Bitboard{sq};
-            const auto blockers = occupied() ^ bb;
-            const auto new_rays = movegen::rook_moves(ksq, blockers);
-            const auto discovery = new_rays ^ rook_rays;
-            const auto attackers = discovery & (pieces(them, Piece::Rook) | pieces(them, Piece::Queen));
-
-            if (attackers) {
-                rook_pinned |= bb;
-                const auto asq = attackers.lsb();
-                const auto move_mask = (squares_between(ksq, asq) ^ bb) & allowed;
-
-                if (bb & pieces(us, Piece::Rook)) {
-                    for (const auto &to : move_mask) {
-                        moves.emplace_back(MoveType::Normal, sq, to, Piece::Rook);
-                    }
-                } else if (bb & pieces(us, Piece::Queen)) {
-                    for (const auto &to : move_mask) {
-                        moves.emplace_back(MoveType::Normal, sq, to, Piece::Queen);
-                    }
-                }
-            }
-        }
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
+        return;
     }
 
-    const Bitboard horizontal_pinned = rook_pinned & krank;
-    const Bitboard pinned_pieces = rook_pinned | bishop_pinned;
-    const Bitboard nonpinned_pieces = occupancy(us) ^ pinned_pieces;
-
-    assert(pinned_pieces == pinned());
-    assert(rook_pinned == (rook_pinned & (kfile | krank)));
+    const auto target = ~occ & ci.check_mask & to_mask;
+    const auto pinned = ci.pinned_diagonal | ci.pinned_orthogonal;
 
     // Pawns
-    if (us == Side::White) {
-        const auto pawns = pieces(us, Piece::Pawn) & ~(horizontal_pinned | bishop_pinned);
-        const auto promo = pawns & bitboards::Rank7;
-        const auto nonpromo = pawns & ~bitboards::Rank7;
-
-        // Singles -- Nonpromo
-        for (const auto &sq : nonpromo.north() & allowed) {
-            moves.emplace_back(MoveType::Normal, sq.south(), sq, Piece::Pawn);
-        }
-
-        // Singles -- Promo
-        for (const auto &sq : promo.north() & allowed) {
-            moves.emplace_back(MoveType::promo, sq.south(), sq, Piece::Pawn, Piece::None, Piece::Queen);
-            moves.emplace_back(MoveType::promo, sq.south(), sq, Piece::Pawn, Piece::None, Piece::Rook);
-            moves.emplace_back(MoveType::promo, sq.south(), sq, Piece::Pawn, Piece::None, Piece::Bishop);
-            moves.emplace_back(MoveType::promo, sq.south(), sq, Piece::Pawn, Piece::None, Piece::Knight);
-        }
-
-        // Doubles
-        const auto doubles = (empty() & pawns.north()).north() & bitboards::Rank4 & allowed;
-        for (const auto &sq : doubles) {
-            moves.emplace_back(MoveType::Double, sq.south().south(), sq, Piece::Pawn);
-        }
-    } else {
-        const auto pawns = pieces(us, Piece::Pawn) & ~(horizontal_pinned | bishop_pinned);
-        const auto promo = pawns & bitboards::Rank2;
-        const auto nonpromo = pawns & ~bitboards::Rank2;
+    {
+        // Pawns pinned along a diagonal can never push
+        const auto pawns = pieces(Us, Piece::Pawn) & ~ci.pinned_diagonal & from_mask;
+        const auto free = pawns & ~ci.pinned_orthogonal;
+        const auto orth = pawns & ci.pinned_orthogonal;
+        const auto singles = (forward<Us>(free) | (forward<Us>(orth) & ci.pin_orthogonal)) & ~occ;
+        const auto doubles = forward<Us>(singles) & ~occ & double_rank & target;
 
         // Singles -- Nonpromo
-        for (const auto &sq : nonpromo.south() & allowed) {
-            moves.emplace_back(MoveType::Normal, sq.north(), sq, Piece::Pawn);
+        for (const auto &sq : singles & target & ~promo_rank) {
+            moves.emplace_back(MoveType::Normal, backward<Us>(sq), sq, Piece::Pawn);
         }
 
         // Singles -- Promo
-        for (const auto &sq : promo.south() & allowed) {
-            moves.emplace_back(MoveType::promo, sq.north(), sq, Piece::Pawn, Piece::None, Piece::Queen);
-            moves.emplace_back(MoveType::promo, sq.north(), sq, Piece::Pawn, Piece::None, Piece::Rook);
-            moves.emplace_back(MoveType::promo, sq.north(), sq, Piece::Pawn, Piece::None, Piece::Bishop);
-            moves.emplace_back(MoveType::promo, sq.north(), sq, Piece::Pawn, Piece::None, Piece::Knight);
+        for (const auto &sq : singles & target & promo_rank) {
+            const auto fr = backward<Us>(sq);
+            moves.emplace_back(MoveType::promo, fr, sq, Piece::Pawn, Piece::None, Piece::Queen);
+            moves.emplace_back(MoveType::promo, fr, sq, Piece::Pawn, Piece::None, Piece::Rook);
+            moves.emplace_back(MoveType::promo, fr, sq, Piece::Pawn, Piece::None, Piece::Bishop);
+            moves.emplace_back(MoveType::promo, fr, sq, Piece::Pawn, Piece::None, Piece::Knight);
         }
 
         // Doubles
-        const auto doubles = (empty() & pawns.south()).south() & bitboards::Rank5 & allowed;
         for (const auto &sq : doubles) {
-            moves.emplace_back(MoveType::Double, sq.north().north(), sq, Piece::Pawn);
+            moves.emplace_back(MoveType::Double, backward<Us>(backward<Us>(sq)), sq, Piece::Pawn);
         }
     }
 
     // Knights
-    for (const auto &fr : pieces(us, Piece::Knight) & nonpinned_pieces) {
-        const auto mask = movegen::knight_moves(fr) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Knight) & ~pinned & from_mask) {
+        const auto mask = movegen::knight_moves(fr) & target;
         for (const auto &to : mask) {
             moves.emplace_back(MoveType::Normal, fr, to, Piece::Knight);
         }
     }
 
     // Bishops
-    for (const auto &fr : pieces(us, Piece::Bishop) & nonpinned_pieces) {
-        const auto mask = movegen::bishop_moves(fr, ~empty()) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Bishop) & ~ci.pinned_orthogonal & from_mask) {
+        auto mask = movegen::bishop_moves(fr, occ) & target;
+        if (ci.pinned_diagonal & fr) {
+            mask &= ci.pin_diagonal;
+        }
         for (const auto &to : mask) {
             moves.emplace_back(MoveType::Normal, fr, to, Piece::Bishop);
         }
     }
 
     // Rooks
-    for (const auto &fr : pieces(us, Piece::Rook) & nonpinned_pieces) {
-        const auto mask = movegen::rook_moves(fr, ~empty()) & allowed;
+    for (const auto &fr : pieces(Us, Piece::Rook) & ~ci.pinned_diagonal & from_mask) {
+        auto mask = movegen::rook_moves(fr, occ) & target;
+        if (ci.pinned_orthogonal & fr) {
+            mask &= ci.pin_orthogonal;
+        }
         for (const auto &to : mask) {
             moves.emplace_back(MoveType::Normal, fr, to, Piece::Rook);
         }
     }
 
     // Queens
-    for (const auto &fr : pieces(us, Piece::Queen) & nonpinned_pieces) {
-        const auto mask = movegen::queen_moves(fr, ~empty()) & allowed;
-        for (const auto &to : mask) {
-            moves.emplace_back(MoveType::Normal, fr, to, Piece::Queen);
+    for (const auto &fr : pieces(Us, Piece::Queen) & from_mask) {
+        Bitboard mask;
+        if (ci.pinned_diagonal & fr) {
+            mask = movegen::bishop_moves(fr, occ) & ci.pin_diagonal;
+        } else if (ci.pinned_orthogonal & fr) {
+            mask = movegen::rook_moves(fr, occ) & ci.pin_orthogonal;
+        } else {
+            mask = movegen::queen_moves(fr, occ);
         }
-    }
-
-    // King
-    {
-        const auto mask = movegen::king_moves(ksq) & king_allowed() & empty();
-        for (const auto &to : mask) {
-            moves.emplace_back(MoveType::Normal, ksq, to, Piece::King);
+        for (const auto &to : mask & target) {
+            moves.emplace_back(MoveType::Normal, fr, to, Piece::Queen);
         }
     }
 
     // Castling
-    if (!checked) {
-        if (us == Side::White) {
-            if (can_castle(Side::White, MoveType::ksc) && piece_on(squares::F1) == Piece::None &&
-                piece_on(squares::G1) == Piece::None && !square_attacked(squares::F1, them) &&
-                !square_attacked(squares::G1, them)) {
-                moves.emplace_back(MoveType::ksc, squares::E1, squares::G1, Piece::King);
-            }
-            if (can_castle(Side::White, MoveType::qsc) && piece_on(squares::D1) == Piece::None &&
-                piece_on(squares::C1) == Piece::None && piece_on(squares::B1) == Piece::None &&
-                !square_attacked(squares::D1, them) && !square_attacked(squares::C1, them)) {
-                moves.emplace_back(MoveType::qsc, squares::E1, squares::C1, Piece::King);
-            }
-        } else {
-            if (can_castle(Side::Black, MoveType::ksc) && piece_on(squares::F8) == Piece::None &&
-                piece_on(squares::G8) == Piece::None && !square_attacked(squares::F8, them) &&
-                !square_attacked(squares::G8, them)) {
-                moves.emplace_back(MoveType::ksc, squares::E8, squares::G8, Piece::King);
-            }
-            if (can_castle(Side::Black, MoveType::qsc) && piece_on(squares::D8) == Piece::None &&
-                piece_on(squares::C8) == Piece::None && piece_on(squares::B8) == Piece::None &&
-                !square_attacked(squares::D8, them) && !square_attacked(squares::C8, them)) {
-                moves.emplace_back(MoveType::qsc, squares::E8, squares::C8, Piece::King);
-            }
+    if (!ci.checkers && (from_mask & ksq)) {
+        constexpr auto ksq_start = relative_square<Us>(squares::E1);
+        constexpr auto ksc_king_to = relative_square<Us>(squares::G1);
+        constexpr auto qsc_king_to = relative_square<Us>(squares::C1);
+        constexpr auto ksc_path = squares_between(ksq_start, ksc_rook_fr[Us]);
+        constexpr auto qsc_path = squares_between(ksq_start, qsc_rook_fr[Us]);
+        constexpr auto ksc_safe = Bitboard{ksc_rook_to[Us]} | ksc_king_to;
+        constexpr auto qsc_safe = Bitboard{qsc_rook_to[Us]} | qsc_king_to;
+
+        if ((to_mask & ksc_king_to) && can_castle(Us, MoveType::ksc) && !(occ & ksc_path) &&
+            !(ci.king_danger & ksc_safe)) {
+            moves.emplace_back(MoveType::ksc, ksq_start, ksc_king_to, Piece::King);
+        }
+        if ((to_mask & qsc_king_to) && can_castle(Us, MoveType::qsc) && !(occ & qsc_path) &&
+            !(ci.king_danger & qsc_safe)) {
+            moves.emplace_back(MoveType::qsc, ksq_start, qsc_king_to, Piece::King);
         }
     }
 
@@ -236,4 +155,11 @@ void Position::legal_noncaptures(std::vector<Move> &moves) const noexcept {
 #endif
 }
 
+template void Position::legal_noncaptures<Side::White>(MoveList &moves,
+                                                      const Bitboard from_mask,
+                                                      const Bitboard to_mask) const noexcept;
+template void Position::legal_noncaptures<Side::Black>(MoveList &moves,
+                                                      const Bitboard from_mask,
+                                                      const Bitboard to_mask) const noexcept;
+
 }  // namespace libchess
@@ -0,0 +1,179 @@
+#include <cassert>
+#include "libchess/bitboard.hpp"
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+#include "libchess/square.hpp"
+
+namespace libchess {
+
+[[nodiscard]] std::vector<Move> Position::legal_quiet_checks() const noexcept {
+    MoveList moves;
+    legal_quiet_checks(moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::legal_quiet_checks(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        legal_quiet_checks<Side::White>(moves);
+    } else {
+        legal_quiet_checks<Side::Black>(moves);
+    }
+}
+
+// The subset of legal_noncaptures() that gives check, each piece only looks at the squares it would check from
+template <Side Us>
+void Position::legal_quiet_checks(MoveList &moves) const noexcept {
+    [[maybe_unused]] const auto start_size = moves.size();
+    constexpr auto them = !Us;
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    constexpr auto double_rank = relative_rank<Us>(3);
+    const auto &ci = check_info();
+    const auto cs = calculate_check_squares<Us>();
+    const auto ksq = king_position(Us);
+    const auto eksq = king_position(them);
+    const auto occ = occupied();
+
+    // Squares a piece gives check from, moving a discovered check candidate off its line counts too
+    const auto checking = [&](const Square fr, const Piece piece) {
+        if (cs.discovered & fr) {
+            return cs.squares[piece] | ~squares_line(eksq, fr);
+        }
+        return cs.squares[piece];
+    };
+
+    // King -- Only discovered checks
+    if (cs.discovered & ksq) {
+        const auto mask = movegen::king_moves(ksq) & ~ci.king_danger & ~occ & ~squares_line(eksq, ksq);
+        for (const auto &to : mask) {
+            moves.emplace_back(MoveType::Normal, ksq, to, Piece::King);
+        }
+    }
+
+    // If we're in check multiple times, only the king can move
+    if (ci.checkers.count() > 1) {
+        return;
+    }
+
+    const auto target = ~occ & ci.check_mask;
+    const auto pinned = ci.pinned_diagonal | ci.pinned_orthogonal;
+
+    // Pawns
+    {
+        // Pawns pinned along a diagonal can never push
+        const auto pawns = pieces(Us, Piece::Pawn) & ~ci.pinned_diagonal;
+        const auto free = pawns & ~ci.pinned_orthogonal;
+        const auto orth = pawns & ci.pinned_orthogonal;
+        const auto singles = (forward<Us>(free) | (forward<Us>(orth) & ci.pin_orthogonal)) & ~occ;
+        const auto doubles = forward<Us>(singles) & ~occ & double_rank & target;
+
+        // A push only stays on the line to the enemy king if that line is the file
+        const auto discovered = forward<Us>(cs.discovered & pieces(Us, Piece::Pawn) & ~bitboards::files[eksq.file()]);
+        const auto single_checks = cs.squares[Piece::Pawn] | discovered;
+        const auto double_checks = cs.squares[Piece::Pawn] | forward<Us>(discovered);
+
+        // Singles -- Nonpromo
+        for (const auto &sq : singles & target & single_checks & ~promo_rank) {
+            moves.emplace_back(MoveType::Normal, backward<Us>(sq), sq, Piece::Pawn);
+        }
+
+        // Singles -- Promo
+        // The promoted piece checks from its own squares, so test them individually
+        for (const auto &sq : singles & target & promo_rank) {
+            const auto fr = backward<Us>(sq);
+            for (const auto promo : {Piece::Queen, Piece::Rook, Piece::Bishop, Piece::Knight}) {
+                const auto move = Move(MoveType::promo, fr, sq, Piece::Pawn, Piece::None, promo);
+                if (gives_check<Us>(move, cs)) {
+                    moves.push_back(move);
+                }
+            }
+        }
+
+        // Doubles
+        for (const auto &sq : doubles & double_checks) {
+            moves.emplace_back(MoveType::Double, backward<Us>(backward<Us>(sq)), sq, Piece::Pawn);
+        }
+    }
+
+    // Knights
+    for (const auto &fr : pieces(Us, Piece::Knight) & ~pinned) {
+        const auto mask = movegen::knight_moves(fr) & target & checking(fr, Piece::Knight);
+        for (const auto &to : mask) {
+            moves.emplace_back(MoveType::Normal, fr, to, Piece::Knight);
+        }
+    }
+
+    // Bishops
+    for (const auto &fr : pieces(Us, Piece::Bishop) & ~ci.pinned_orthogonal) {
+        auto mask = movegen::bishop_moves(fr, occ) & target & checking(fr, Piece::Bishop);
+        if (ci.pinned_diagonal & fr) {
+            mask &= ci.pin_diagonal;
+        }
+        for (const auto &to : mask) {
+            moves.emplace_back(MoveType::Normal, fr, to, Piece::Bishop);
+        }
+    }
+
+    // Rooks
+    for (const auto &fr : pieces(Us, Piece::Rook) & ~ci.pinned_diagonal) {
+        auto mask = movegen::rook_moves(fr, occ) & target & checking(fr, Piece::Rook);
+        if (ci.pinned_orthogonal & fr) {
+            mask &= ci.pin_orthogonal;
+        }
+        for (const auto &to : mask) {
+            moves.emplace_back(MoveType::Normal, fr, to, Piece::Rook);
+        }
+    }
+
+    // Queens
+    for (const auto &fr : pieces(Us, Piece::Queen)) {
+        Bitboard mask;
+        if (ci.pinned_diagonal & fr) {
+            mask = movegen::bishop_moves(fr, occ) & ci.pin_diagonal;
+        } else if (ci.pinned_orthogonal & fr) {
+            mask = movegen::rook_moves(fr, occ) & ci.pin_orthogonal;
+        } else {
+            mask = movegen::queen_moves(fr, occ);
+        }
+        for (const auto &to : mask & target & checking(fr, Piece::Queen)) {
+            moves.emplace_back(MoveType::Normal, fr, to, Piece::Queen);
+        }
+    }
+
+    // Castling -- Only the rook can give check
+    if (!ci.checkers) {
+        constexpr auto ksq_start = relative_square<Us>(squares::E1);
+        constexpr auto ksc_king_to = relative_square<Us>(squares::G1);
+        constexpr auto qsc_king_to = relative_square<Us>(squares::C1);
+        constexpr auto ksc_path = squares_between(ksq_start, ksc_rook_fr[Us]);
+        constexpr auto qsc_path = squares_between(ksq_start, qsc_rook_fr[Us]);
+        constexpr auto ksc_safe = Bitboard{ksc_rook_to[Us]} | ksc_king_to;
+        constexpr auto qsc_safe = Bitboard{qsc_rook_to[Us]} | qsc_king_to;
+
+        if (can_castle(Us, MoveType::ksc) && !(occ & ksc_path) && !(ci.king_danger & ksc_safe)) {
+            const auto move = Move(MoveType::ksc, ksq_start, ksc_king_to, Piece::King);
+            if (gives_check<Us>(move, cs)) {
+                moves.push_back(move);
+            }
+        }
+        if (can_castle(Us, MoveType::qsc) && !(occ & qsc_path) && !(ci.king_danger & qsc_safe)) {
+            const auto move = Move(MoveType::qsc, ksq_start, qsc_king_to, Piece::King);
+            if (gives_check<Us>(move, cs)) {
+                moves.push_back(move);
+            }
+        }
+    }
+
+#ifndef NDEBUG
+    for (std::size_t i = start_size; i < moves.size(); ++i) {
+        assert(!moves[i].is_capturing());
+        assert(gives_check<Us>(moves[i], cs));
+        assert(is_legal<Us>(moves[i]));
+    }
+#endif
+}
+
+template void Position::legal_quiet_checks<Side::White>(MoveList &moves) const noexcept;
+template void Position::legal_quiet_checks<Side::Black>(MoveList &moves) const noexcept;
+
+}  // namespace libchess
@@ -249,6 +249,52 @@ constexpr auto lut_squares_between = calculate_squares_between();
     return lut_squares_between[static_cast<int>(sq1)][static_cast<int>(sq2)];
 }
 
+constexpr std::array<std::array<Bitboard, 64>, 64> calculate_squares_line() {
+    std::array<std::array<Bitboard, 64>, 64> result;
+
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            const auto sq1 = Square{i};
+            const auto sq2 = Square{j};
+
+            const auto dx = (sq2.file() - sq1.file());
+            const auto dy = (sq2.rank() - sq1.rank());
+            const auto adx = dx > 0 ? dx : -dx;
+            const auto ady = dy > 0 ? dy : -dy;
+
+            if (i != j && (dx == 0 || dy == 0 || adx == ady)) {
+                const auto sx = dx > 0 ? 1 : dx < 0 ? -1 : 0;
+                const auto sy = dy > 0 ? 1 : dy < 0 ? -1 : 0;
+                Bitboard mask;
+
+                // Walk from one edge of the board to the other through sq1
+                int x = sq1.file();
+                int y = sq1.rank();
+                while (x - sx >= 0 && x - sx <= 7 && y - sy >= 0 && y - sy <= 7) {
+                    x -= sx;
+                    y -= sy;
+                }
+                while (x >= 0 && x <= 7 && y >= 0 && y <= 7) {
+                    mask |= Bitboard{Square{x, y}};
+                    x += sx;
+                    y += sy;
+                }
+
+                result[i][j] = mask;
+            }
+        }
+    }
+
+    return result;
+}
+
+constexpr auto lut_squares_line = calculate_squares_line();
+
+// The full line through both squares, or empty if they aren't aligned
+[[nodiscard]] constexpr Bitboard squares_line(const Square sq1, const Square sq2) {
+    return lut_squares_line[static_cast<int>(sq1)][static_cast<int>(sq2)];
+}
+
 namespace bitboards {
 
 constexpr auto FileA = Bitboard(0x0101010101010101);
@@ -377,6 +423,13 @@ static_assert(squares_between(squares::A1, squares::B3).empty());
 static_assert(squares_between(squares::A1, squares::C2).empty());
 static_assert(squares_between(squares::B3, squares::A1).empty());
 static_assert(squares_between(squares::B3, squares::A1).empty());
+// Lines
+static_assert(squares_line(squares::A1, squares::A4) == bitboards::FileA);
+static_assert(squares_line(squares::D1, squares::A1) == bitboards::Rank1);
+static_assert(squares_line(squares::D4, squares::A1) == Bitboard(0x8040201008040201));
+static_assert(squares_line(squares::A4, squares::D1) == Bitboard(0x1020408));
+static_assert(squares_line(squares::A1, squares::A1).empty());
+static_assert(squares_line(squares::A1, squares::B3).empty());
 
 }  // namespace libchess
 
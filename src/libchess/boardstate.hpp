@@ -0,0 +1,174 @@
+#ifndef LIBCHESS_BOARDSTATE_HPP
+#define LIBCHESS_BOARDSTATE_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "bitboard.hpp"
+#include "move.hpp"
+#include "piece.hpp"
+#include "side.hpp"
+#include "square.hpp"
+#include "zobrist.hpp"
+
+namespace libchess {
+
+namespace {
+
+// Bits of the castling rights mask
+enum Castling : std::uint8_t
+{
+    WhiteKSC = 1,
+    WhiteQSC = 2,
+    BlackKSC = 4,
+    BlackQSC = 8,
+};
+
+constexpr const Square ksc_rook_fr[] = {squares::H1, squares::H8};
+constexpr const Square qsc_rook_fr[] = {squares::A1, squares::A8};
+constexpr const Square ksc_rook_to[] = {squares::F1, squares::F8};
+constexpr const Square qsc_rook_to[] = {squares::D1, squares::D8};
+
+// The castling rights that survive a move to or from each square
+constexpr std::array<std::uint8_t, 64> castling_kept = [] {
+    std::array<std::uint8_t, 64> kept = {};
+    for (auto &rights : kept) {
+        rights = WhiteKSC | WhiteQSC | BlackKSC | BlackQSC;
+    }
+    kept[static_cast<int>(squares::E1)] &= ~(WhiteKSC | WhiteQSC);
+    kept[static_cast<int>(squares::H1)] &= ~WhiteKSC;
+    kept[static_cast<int>(squares::A1)] &= ~WhiteQSC;
+    kept[static_cast<int>(squares::E8)] &= ~(BlackKSC | BlackQSC);
+    kept[static_cast<int>(squares::H8)] &= ~BlackKSC;
+    kept[static_cast<int>(squares::A8)] &= ~BlackQSC;
+    return kept;
+}();
+
+}  // namespace
+
+// Everything about a position except how it was reached
+// Trivially copyable, so copy-make search can keep one per ply and states can be handed to other threads
+struct alignas(64) BoardState {
+    [[nodiscard]] constexpr Bitboard occupancy(const Side s) const noexcept {
+        return colour_bb[s];
+    }
+
+    [[nodiscard]] constexpr Bitboard occupancy(const Piece p) const noexcept {
+        return piece_bb[p];
+    }
+
+    [[nodiscard]] constexpr Bitboard pieces(const Side s, const Piece p) const noexcept {
+        return occupancy(s) & occupancy(p);
+    }
+
+    [[nodiscard]] constexpr Bitboard occupied() const noexcept {
+        return occupancy(Side::White) | occupancy(Side::Black);
+    }
+
+    [[nodiscard]] constexpr Piece piece_on(const Square sq) const noexcept {
+        for (int i = 0; i < 6; ++i) {
+            if (piece_bb[i] & Bitboard{sq}) {
+                return Piece(i);
+            }
+        }
+        return Piece::None;
+    }
+
+    [[nodiscard]] constexpr bool can_castle(const Side s, const MoveType mt) const noexcept {
+        if (s == Side::White) {
+            return castling & (mt == MoveType::ksc ? WhiteKSC : WhiteQSC);
+        } else {
+            return castling & (mt == MoveType::ksc ? BlackKSC : BlackQSC);
+        }
+    }
+
+    [[nodiscard]] constexpr std::uint64_t calculate_hash() const noexcept {
+        std::uint64_t key = 0;
+
+        // Turn
+        if (turn == Side::Black) {
+            key ^= zobrist::turn_key();
+        }
+
+        // Pieces
+        for (const auto s : {Side::White, Side::Black}) {
+            for (const auto &sq : pieces(s, Piece::Pawn)) {
+                key ^= zobrist::piece_key(Piece::Pawn, s, sq);
+            }
+            for (const auto &sq : pieces(s, Piece::Knight)) {
+                key ^= zobrist::piece_key(Piece::Knight, s, sq);
+            }
+            for (const auto &sq : pieces(s, Piece::Bishop)) {
+                key ^= zobrist::piece_key(Piece::Bishop, s, sq);
+            }
+            for (const auto &sq : pieces(s, Piece::Rook)) {
+                key ^= zobrist::piece_key(Piece::Rook, s, sq);
+            }
+            for (const auto &sq : pieces(s, Piece::Queen)) {
+                key ^= zobrist::piece_key(Piece::Queen, s, sq);
+            }
+            for (const auto &sq : pieces(s, Piece::King)) {
+                key ^= zobrist::piece_key(Piece::King, s, sq);
+            }
+        }
+
+        // Castling
+        key ^= zobrist::castling_rights_key(castling);
+
+        // EP
+        if (ep != squares::OffSq) {
+            key ^= zobrist::ep_key(ep);
+        }
+
+        return key;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t calculate_pawn_hash() const noexcept {
+        std::uint64_t key = 0;
+        for (const auto s : {Side::White, Side::Black}) {
+            for (const auto &sq : pieces(s, Piece::Pawn)) {
+                key ^= zobrist::piece_key(Piece::Pawn, s, sq);
+            }
+        }
+        return key;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t calculate_material_key() const noexcept {
+        std::uint64_t key = 0;
+        for (const auto s : {Side::White, Side::Black}) {
+            for (const auto p :
+                 {Piece::Pawn, Piece::Knight, Piece::Bishop, Piece::Rook, Piece::Queen, Piece::King}) {
+                for (int i = 0; i < pieces(s, p).count(); ++i) {
+                    key ^= zobrist::material_key(p, s, i);
+                }
+            }
+        }
+        return key;
+    }
+
+    // The state after a legal move, the original is left untouched
+    [[nodiscard]] BoardState after(const Move &move) const noexcept;
+
+    // Us is the side making the move
+    template <Side Us>
+    void makemove(const Move &move) noexcept;
+
+    Bitboard colour_bb[2] = {};
+    Bitboard piece_bb[6] = {};
+    std::uint64_t hash = 0;
+    std::uint64_t pawn_hash = 0;
+    std::uint64_t material_key = 0;
+    std::uint16_t halfmove_clock = 0;
+    std::uint16_t fullmove_clock = 0;
+    Square ep = squares::OffSq;
+    // Castling bits
+    std::uint8_t castling = 0;
+    Side turn = Side::White;
+};
+
+static_assert(std::is_trivially_copyable_v<BoardState>);
+static_assert(sizeof(BoardState) <= 128);
+
+}  // namespace libchess
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef LIBCHESS_CHECKINFO_HPP
+#define LIBCHESS_CHECKINFO_HPP
+
+#include "bitboard.hpp"
+
+namespace libchess {
+
+// Everything the legal move generators need to know about the safety of the king of the side to move
+struct CheckInfo {
+    // Enemy pieces giving check
+    Bitboard checkers;
+    // Squares a non-king move has to land on, every square when not in check and none in double check
+    Bitboard check_mask;
+    // Our pieces pinned along a diagonal or along a rank or file
+    Bitboard pinned_diagonal;
+    Bitboard pinned_orthogonal;
+    // The squares between the king and each pinning piece, pinners included
+    Bitboard pin_diagonal;
+    Bitboard pin_orthogonal;
+    // Squares attacked by the enemy, sliders see through our king
+    Bitboard king_danger;
+};
+
+// What the side to move needs to know to give check to the enemy king
+struct CheckSquares {
+    // Squares each of our piece types would give check from
+    Bitboard squares[6];
+    // Our pieces that uncover a check from one of our sliders when they move off the line
+    Bitboard discovered;
+};
+
+}  // namespace libchess
+
+#endif
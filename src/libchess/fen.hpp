@@ -0,0 +1,70 @@
+#ifndef LIBCHESS_FEN_HPP
+#define LIBCHESS_FEN_HPP
+
+#include <cstddef>
+#include <string_view>
+#include "boardstate.hpp"
+
+namespace libchess {
+
+// The first problem found in a FEN string
+enum class FenError : int
+{
+    None = 0,
+    Board,
+    Kings,
+    Pawns,
+    Turn,
+    Castling,
+    EnPassant,
+    HalfmoveClock,
+    FullmoveClock,
+    Trailing,
+    Check,
+};
+
+[[nodiscard]] constexpr std::string_view fen_error_message(const FenError error) noexcept {
+    switch (error) {
+        case FenError::None:
+            return "no error";
+        case FenError::Board:
+            return "malformed piece placement";
+        case FenError::Kings:
+            return "each side needs exactly one king";
+        case FenError::Pawns:
+            return "pawns on the first or last rank";
+        case FenError::Turn:
+            return "side to move isn't w or b";
+        case FenError::Castling:
+            return "castling rights don't match the board";
+        case FenError::EnPassant:
+            return "en passant square doesn't match the board";
+        case FenError::HalfmoveClock:
+            return "bad halfmove clock";
+        case FenError::FullmoveClock:
+            return "bad fullmove number";
+        case FenError::Trailing:
+            return "unexpected text after the fullmove number";
+        case FenError::Check:
+            return "the side not to move is in check";
+        default:
+            return "unknown error";
+    }
+}
+
+struct FenResult {
+    FenError error = FenError::None;
+    // Where in the string the error was found, the start of the field or the offending character
+    std::size_t offset = 0;
+    // Only meaningful if there's no error
+    BoardState state;
+};
+
+// Doesn't allocate, "startpos" is accepted as well
+// The move clocks can be left off and default to 0 and 1
+// An en passant square without their pawn in front of it is dropped, not an error
+[[nodiscard]] FenResult parse_fen(std::string_view fen) noexcept;
+
+}  // namespace libchess
+
+#endif
@@ -1,9 +1,11 @@
 #ifndef LIBCHESS_MOVE_HPP
 #define LIBCHESS_MOVE_HPP
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <ostream>
+#include <string>
 #include "piece.hpp"
 #include "square.hpp"
 
@@ -137,16 +139,7 @@ class Move {
         return data_;
     }
 
-    [[nodiscard]] operator std::string() const noexcept {
-        std::string str;
-        str += static_cast<std::string>(from());
-        str += static_cast<std::string>(to());
-        if (promotion() != Piece::None) {
-            const char asd[] = {'n', 'b', 'r', 'q'};
-            str += asd[promotion() - 1];
-        }
-        return str;
-    }
+    [[nodiscard]] operator std::string() const noexcept;
 
     [[nodiscard]] constexpr bool operator==(const Move &rhs) const noexcept {
         return data_ == rhs.data_;
@@ -168,12 +161,41 @@ class Move {
     std::uint32_t data_ = 0;
 };
 
+// Writes the move in UCI notation into the buffer without a terminator, which needs room for 5 characters
+// Returns one past the last character written
+constexpr char *write_uci(char *out, const Move &move) noexcept {
+    out = write_uci(out, move.from());
+    out = write_uci(out, move.to());
+    if (move.promotion() != Piece::None) {
+        constexpr char promos[] = {'n', 'b', 'r', 'q'};
+        *out++ = promos[move.promotion() - 1];
+    }
+    return out;
+}
+
+// Null terminated
+[[nodiscard]] constexpr std::array<char, 6> to_uci(const Move &move) noexcept {
+    std::array<char, 6> str = {};
+    write_uci(str.data(), move);
+    return str;
+}
+
+inline Move::operator std::string() const noexcept {
+    char buf[5];
+    return std::string(buf, write_uci(buf, *this));
+}
+
 inline std::ostream &operator<<(std::ostream &os, const Move &move) noexcept {
-    os << static_cast<std::string>(move);
+    char buf[5];
+    os.write(buf, write_uci(buf, move) - buf);
     return os;
 }
 
 static_assert(sizeof(Move) == sizeof(std::uint32_t));
+static_assert(to_uci(Move(MoveType::Double, squares::A2, squares::A4, Piece::Pawn)) ==
+              std::array<char, 6>{{'a', '2', 'a', '4', '\0', '\0'}});
+static_assert(to_uci(Move(MoveType::promo, squares::A7, squares::A8, Piece::Pawn, Piece::None, Piece::Knight)) ==
+              std::array<char, 6>{{'a', '7', 'a', '8', 'n', '\0'}});
 static_assert(!Move(MoveType::Normal, squares::A2, squares::A3, Piece::Pawn).is_promoting());
 static_assert(!Move(MoveType::Normal, squares::A2, squares::A3, Piece::Pawn).is_capturing());
 static_assert(Move(MoveType::promo, squares::A7, squares::A8, Piece::Pawn, Piece::None, Piece::Queen).is_promoting());
@@ -6,12 +6,28 @@
 
 namespace libchess::movegen {
 
+enum class SliderBackend : int
+{
+    Magic = 0,
+    Pext,
+};
+
+// The slider attack lookup selected for this CPU at startup
+[[nodiscard]] SliderBackend slider_backend() noexcept;
+
+// Whether this CPU can run the backend at all, PEXT can be supported but too slow to be selected
+[[nodiscard]] bool slider_backend_supported(const SliderBackend backend) noexcept;
+
 Bitboard knight_moves(const Square sq);
 Bitboard bishop_moves(const Square sq, const Bitboard &occ);
 Bitboard rook_moves(const Square sq, const Bitboard &occ);
 Bitboard queen_moves(const Square sq, const Bitboard &occ);
 Bitboard king_moves(const Square sq);
 
+// Lookups through a particular backend rather than the selected one, so each can be tested
+Bitboard bishop_moves(const SliderBackend backend, const Square sq, const Bitboard &occ);
+Bitboard rook_moves(const SliderBackend backend, const Square sq, const Bitboard &occ);
+
 }  // namespace libchess::movegen
 
 #endif
@@ -0,0 +1,104 @@
+#ifndef LIBCHESS_MOVELIST_HPP
+#define LIBCHESS_MOVELIST_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "move.hpp"
+
+namespace libchess {
+
+// Fixed capacity move container that lives on the stack, only the first size() moves are valid
+class MoveList {
+   public:
+    static constexpr std::size_t capacity = 256;
+
+    [[nodiscard]] constexpr MoveList() = default;
+
+    template <typename... Args>
+    void emplace_back(Args &&...args) noexcept {
+        assert(size_ < capacity);
+        ::new (static_cast<void *>(storage_ + size_ * sizeof(Move))) Move(std::forward<Args>(args)...);
+        size_++;
+    }
+
+    void push_back(const Move &move) noexcept {
+        assert(size_ < capacity);
+        ::new (static_cast<void *>(storage_ + size_ * sizeof(Move))) Move(move);
+        size_++;
+    }
+
+    constexpr void resize(const std::size_t n) noexcept {
+        assert(n <= size_);
+        size_ = n;
+    }
+
+    constexpr void clear() noexcept {
+        size_ = 0;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] Move &operator[](const std::size_t n) noexcept {
+        assert(n < size_);
+        return data()[n];
+    }
+
+    [[nodiscard]] const Move &operator[](const std::size_t n) const noexcept {
+        assert(n < size_);
+        return data()[n];
+    }
+
+    [[nodiscard]] Move *begin() noexcept {
+        return data();
+    }
+
+    [[nodiscard]] Move *end() noexcept {
+        return data() + size_;
+    }
+
+    [[nodiscard]] const Move *begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] const Move *end() const noexcept {
+        return data() + size_;
+    }
+
+    [[nodiscard]] bool contains(const Move &move) const noexcept {
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (data()[i] == move) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+   private:
+    [[nodiscard]] Move *data() noexcept {
+        return std::launder(reinterpret_cast<Move *>(storage_));
+    }
+
+    [[nodiscard]] const Move *data() const noexcept {
+        return std::launder(reinterpret_cast<const Move *>(storage_));
+    }
+
+    std::size_t size_ = 0;
+    // Raw storage, Move zeroes itself so an array of them would clear the whole list on construction
+    alignas(Move) std::byte storage_[capacity * sizeof(Move)];
+};
+
+static_assert(std::is_trivially_copyable_v<Move>);
+static_assert(std::is_trivially_destructible_v<MoveList>);
+
+}  // namespace libchess
+
+#endif
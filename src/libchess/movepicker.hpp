@@ -0,0 +1,116 @@
+#ifndef LIBCHESS_MOVEPICKER_HPP
+#define LIBCHESS_MOVEPICKER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include "move.hpp"
+#include "movelist.hpp"
+#include "position.hpp"
+
+namespace libchess {
+
+// Staged move generation for search
+// Each stage is only generated once the previous stage has been exhausted,
+// so a cutoff on the hash move or a capture never pays for the quiet moves
+class MovePicker {
+   public:
+    enum class Stage : int
+    {
+        HashMove = 0,
+        GenerateCaptures,
+        Captures,
+        GenerateQuiets,
+        Promotions,
+        Quiets,
+        Done,
+    };
+
+    [[nodiscard]] explicit MovePicker(const Position &pos, const Move &hash_move = Move{}) noexcept
+        : pos_{pos}, hash_move_{hash_move} {
+    }
+
+    // Returns the next legal move, or a null move once every stage is exhausted
+    [[nodiscard]] Move next() noexcept {
+        switch (stage_) {
+            case Stage::HashMove:
+                stage_ = Stage::GenerateCaptures;
+                if (hash_move_ && pos_.is_legal(hash_move_)) {
+                    return hash_move_;
+                }
+                [[fallthrough]];
+            case Stage::GenerateCaptures:
+                moves_.clear();
+                pos_.legal_captures(moves_);
+                // MVV-LVA
+                std::sort(moves_.begin(), moves_.end(), [](const Move &a, const Move &b) {
+                    if (a.captured() != b.captured()) {
+                        return a.captured() > b.captured();
+                    }
+                    return a.piece() < b.piece();
+                });
+                idx_ = 0;
+                stage_ = Stage::Captures;
+                [[fallthrough]];
+            case Stage::Captures:
+                while (idx_ < moves_.size()) {
+                    const auto move = moves_[idx_++];
+                    if (move != hash_move_) {
+                        return move;
+                    }
+                }
+                stage_ = Stage::GenerateQuiets;
+                [[fallthrough]];
+            case Stage::GenerateQuiets:
+                moves_.clear();
+                pos_.legal_noncaptures(moves_);
+                num_promos_ = static_cast<std::size_t>(std::partition(moves_.begin(),
+                                                                      moves_.end(),
+                                                                      [](const Move &move) {
+                                                                          return move.is_promoting();
+                                                                      }) -
+                                                       moves_.begin());
+                idx_ = 0;
+                stage_ = Stage::Promotions;
+                [[fallthrough]];
+            case Stage::Promotions:
+                while (idx_ < num_promos_) {
+                    const auto move = moves_[idx_++];
+                    if (move != hash_move_) {
+                        return move;
+                    }
+                }
+                stage_ = Stage::Quiets;
+                [[fallthrough]];
+            case Stage::Quiets:
+                while (idx_ < moves_.size()) {
+                    const auto move = moves_[idx_++];
+                    if (move != hash_move_) {
+                        return move;
+                    }
+                }
+                stage_ = Stage::Done;
+                [[fallthrough]];
+            case Stage::Done:
+                return Move{};
+            default:
+                abort();
+        }
+    }
+
+    [[nodiscard]] constexpr Stage stage() const noexcept {
+        return stage_;
+    }
+
+   private:
+    const Position &pos_;
+    Move hash_move_;
+    Stage stage_ = Stage::HashMove;
+    MoveList moves_;
+    std::size_t idx_ = 0;
+    std::size_t num_promos_ = 0;
+};
+
+}  // namespace libchess
+
+#endif
@@ -25,6 +25,9 @@ inline constexpr std::array<Piece, 6> pieces = {{
     Piece::King,
 }};
 
+// Used by the static exchange evaluation, the king is worth more than everything else combined
+inline constexpr std::array<int, 7> piece_values = {{100, 300, 300, 500, 900, 20000, 0}};
+
 }  // namespace libchess
 
 #endif
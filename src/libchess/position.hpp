@@ -1,12 +1,20 @@
 #ifndef LIBCHESS_POSITION_HPP
 #define LIBCHESS_POSITION_HPP
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <optional>
 #include <ostream>
-#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "bitboard.hpp"
+#include "boardstate.hpp"
+#include "checkinfo.hpp"
+#include "fen.hpp"
 #include "move.hpp"
+#include "movelist.hpp"
 #include "piece.hpp"
 #include "side.hpp"
 #include "zobrist.hpp"
@@ -15,47 +23,73 @@ namespace libchess {
 
 namespace {
 
-enum Castling : int
-{
-    usKSC,
-    usQSC,
-    themKSC,
-    themQSC
-};
-
-constexpr const Square ksc_rook_fr[] = {squares::H1, squares::H8};
-constexpr const Square qsc_rook_fr[] = {squares::A1, squares::A8};
-constexpr const Square ksc_rook_to[] = {squares::F1, squares::F8};
-constexpr const Square qsc_rook_to[] = {squares::D1, squares::D8};
+[[nodiscard]] constexpr std::array<Piece, 64> make_empty_board() noexcept {
+    std::array<Piece, 64> board = {};
+    for (auto &piece : board) {
+        piece = Piece::None;
+    }
+    return board;
+}
 
 }  // namespace
 
+enum class GameStatus : int
+{
+    Ongoing = 0,
+    Checkmate,
+    Stalemate,
+    FiftyMoves,
+    Threefold,
+};
+
 class Position {
    public:
-    [[nodiscard]] Position() = default;
+    // Nothing is reserved up front, the first makemove() makes room for the history and a copy only takes what it holds
+    [[nodiscard]] Position() noexcept = default;
 
-    [[nodiscard]] explicit Position(const std::string &fen) {
+    [[nodiscard]] Position(const Position &other);
+
+    [[nodiscard]] Position(Position &&) noexcept = default;
+
+    Position &operator=(const Position &other);
+
+    Position &operator=(Position &&) noexcept = default;
+
+    ~Position() noexcept;
+
+    // Throws std::invalid_argument if the FEN is invalid
+    [[nodiscard]] explicit Position(const std::string_view fen) : Position() {
         set_fen(fen);
     }
 
+    // Starts a new game from the state, such as one produced by BoardState::after() or parse_fen()
+    // Doesn't allocate or reserve the history, so copy-make search can cheaply build one per node
+    [[nodiscard]] explicit Position(const BoardState &state) noexcept {
+        set_state(state);
+    }
+
+    [[nodiscard]] constexpr const BoardState &state() const noexcept {
+        return state_;
+    }
+
     [[nodiscard]] constexpr Side turn() const noexcept {
-        return to_move_;
+        return state_.turn;
     }
 
     [[nodiscard]] constexpr Bitboard occupancy(const Side s) const noexcept {
-        return colours_[s];
+        return state_.occupancy(s);
     }
 
     [[nodiscard]] constexpr Bitboard occupancy(const Piece p) const noexcept {
-        return pieces_[p];
+        return state_.occupancy(p);
     }
 
     [[nodiscard]] constexpr Bitboard pieces(const Side s, const Piece p) const noexcept {
-        return occupancy(s) & occupancy(p);
+        return state_.pieces(s, p);
     }
 
     [[nodiscard]] constexpr Bitboard occupied() const noexcept {
-        return occupancy(Side::White) | occupancy(Side::Black);
+        return state_.occupied();
     }
 
     [[nodiscard]] constexpr Bitboard empty() const noexcept {
@@ -63,39 +97,93 @@ class Position {
     }
 
     [[nodiscard]] constexpr std::uint64_t hash() const noexcept {
-        return hash_;
+        return state_.hash;
+    }
+
+    // Only covers the pawns, for pawn structure caches
+    [[nodiscard]] constexpr std::uint64_t pawn_hash() const noexcept {
+        return state_.pawn_hash;
+    }
+
+    // Only depends on the number of each piece, not where they are
+    [[nodiscard]] constexpr std::uint64_t material_key() const noexcept {
+        return state_.material_key;
     }
 
-    void set_fen(const std::string &fen) noexcept;
+    // Throws std::invalid_argument if the FEN is invalid, the position is left unchanged
+    void set_fen(const std::string_view fen);
+
+    // Leaves the position unchanged if the FEN is invalid
+    [[nodiscard]] FenError try_set_fen(const std::string_view fen) noexcept;
 
     [[nodiscard]] std::string get_fen() const noexcept;
 
     [[nodiscard]] bool is_legal(const Move &m) const noexcept;
 
+    template <Side Us>
+    [[nodiscard]] bool is_legal(const Move &m) const noexcept;
+
+    [[nodiscard]] bool has_legal_move() const noexcept;
+
+    template <Side Us>
+    [[nodiscard]] bool has_legal_move() const noexcept;
+
+    // Checkmate takes precedence over the draw rules
+    [[nodiscard]] GameStatus game_status() const noexcept {
+        if (!has_legal_move()) {
+            return in_check() ? GameStatus::Checkmate : GameStatus::Stalemate;
+        } else if (fiftymoves()) {
+            return GameStatus::FiftyMoves;
+        } else if (threefold()) {
+            return GameStatus::Threefold;
+        }
+        return GameStatus::Ongoing;
+    }
+
     [[nodiscard]] bool is_terminal() const noexcept {
-        return legal_moves().empty() || is_draw();
+        return game_status() != GameStatus::Ongoing;
     }
 
     [[nodiscard]] bool is_checkmate() const noexcept {
-        return legal_moves().empty() && in_check();
+        return in_check() && !has_legal_move();
     }
 
     [[nodiscard]] bool is_stalemate() const noexcept {
-        return legal_moves().empty() && !in_check();
+        return !in_check() && !has_legal_move();
     }
-    
+
     [[nodiscard]] bool is_draw() const noexcept {
         return (threefold() || fiftymoves()) && !is_checkmate();
     }
-    
+
     [[nodiscard]] bool threefold() const noexcept {
-        if (halfmove_clock_ < 8) {
+        if (state_.halfmove_clock < 8) {
             return false;
         }
 
         int repeats = 0;
         for (std::size_t i = 2; i <= history_.size() && i <= halfmoves(); i += 2) {
-            if (history_[history_.size() - i].hash == hash_) {
+            if (history_[history_.size() - i].hash == state_.hash) {
+                repeats++;
+                if (repeats >= 2) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // For search, ply is how many moves ago the root was
+    // A single repeat after the root counts, before that it takes two
+    // Only looks back as far as the last irreversible move
+    [[nodiscard]] bool is_repetition(const int ply) const noexcept {
+        const auto end = std::min<std::size_t>(halfmoves(), history_.size());
+        int repeats = 0;
+        for (std::size_t i = 4; i <= end; i += 2) {
+            if (history_[history_.size() - i].hash == state_.hash) {
+                if (static_cast<int>(i) < ply) {
+                    return true;
+                }
                 repeats++;
                 if (repeats >= 2) {
                     return true;
@@ -105,16 +193,19 @@ class Position {
         return false;
     }
 
+    // Whether the side to move has a reversible move that reaches a position seen before
+    [[nodiscard]] bool upcoming_repetition(const int ply) const noexcept;
+
     [[nodiscard]] constexpr bool fiftymoves() const noexcept {
-        return halfmove_clock_ >= 100;
+        return state_.halfmove_clock >= 100;
     }
 
     [[nodiscard]] constexpr std::size_t halfmoves() const noexcept {
-        return halfmove_clock_;
+        return state_.halfmove_clock;
     }
 
     [[nodiscard]] constexpr std::size_t fullmoves() const noexcept {
-        return fullmove_clock_;
+        return state_.fullmove_clock;
     }
 
     [[nodiscard]] constexpr Square king_position(const Side s) const noexcept {
@@ -125,24 +216,59 @@ class Position {
 
     [[nodiscard]] Bitboard squares_attacked(const Side s) const noexcept;
 
+    template <Side S>
+    [[nodiscard]] Bitboard squares_attacked() const noexcept;
+
     [[nodiscard]] Bitboard checkers() const noexcept;
 
     [[nodiscard]] Bitboard attackers(const Square sq, const Side s) const noexcept;
 
+    template <Side S>
+    [[nodiscard]] Bitboard attackers(const Square sq) const noexcept;
+
+    // Attackers of both sides, given an occupancy so pieces can be removed to reveal x-rays
+    [[nodiscard]] Bitboard attackers_to(const Square sq, const Bitboard occ) const noexcept;
+
+    // Static exchange evaluation
+    [[nodiscard]] int see(const Move &move) const noexcept;
+
+    [[nodiscard]] bool see_ge(const Move &move, const int threshold) const noexcept;
+
     [[nodiscard]] bool in_check() const noexcept {
-        return square_attacked(king_position(turn()), !turn());
+        return !checkers().empty();
+    }
+
+    // Kept up to date by everything that changes the position, so const access never writes
+    // After makemove_pseudo() it's worked out on each call instead, until the move is undone
+    [[nodiscard]] CheckInfo check_info() const noexcept {
+        return check_info_ ? *check_info_ : calculate_check_info();
     }
 
+    // Only gives_check() needs these, so they're worked out on each call rather than by makemove()
+    [[nodiscard]] CheckSquares check_squares() const noexcept;
+
+    [[nodiscard]] bool gives_check(const Move &move) const noexcept;
+
+    // For testing several moves in the same position without working out the check squares each time
+    [[nodiscard]] bool gives_check(const Move &move, const CheckSquares &cs) const noexcept;
+
+    template <Side Us>
+    [[nodiscard]] bool gives_check(const Move &move, const CheckSquares &cs) const noexcept;
+
     [[nodiscard]] Bitboard king_allowed() const noexcept;
 
     [[nodiscard]] Bitboard king_allowed(const Side s) const noexcept;
 
+    template <Side S>
+    [[nodiscard]] Bitboard king_allowed() const noexcept;
+
     [[nodiscard]] Bitboard pinned() const noexcept;
 
     [[nodiscard]] Bitboard pinned(const Side s) const noexcept;
 
     [[nodiscard]] Bitboard pinned(const Side s, const Square sq) const noexcept;
 
+    // Every legal move when in check, otherwise only the king's non-castling moves
     [[nodiscard]] std::vector<Move> check_evasions() const noexcept;
 
     [[nodiscard]] std::vector<Move> legal_moves() const noexcept;
@@ -151,10 +277,68 @@ class Position {
 
     [[nodiscard]] std::vector<Move> legal_noncaptures() const noexcept;
 
+    // Non-captures that give check
+    [[nodiscard]] std::vector<Move> legal_quiet_checks() const noexcept;
+
+    // Legal moves landing on a square, starting on a square, or made by one of our piece types
+    [[nodiscard]] std::vector<Move> legal_moves_to(const Square sq) const noexcept;
+
+    [[nodiscard]] std::vector<Move> legal_moves_from(const Square sq) const noexcept;
+
+    [[nodiscard]] std::vector<Move> legal_moves_of(const Piece piece) const noexcept;
+
+    // Moves that may leave our king in check, filter them with is_pseudo_legal_move_legal()
+    [[nodiscard]] std::vector<Move> pseudo_legal_moves() const noexcept;
+
+    // Only valid for moves generated by pseudo_legal_moves() in this position
+    [[nodiscard]] bool is_pseudo_legal_move_legal(const Move &move) const noexcept;
+
     void legal_captures(std::vector<Move> &moves) const noexcept;
 
     void legal_noncaptures(std::vector<Move> &moves) const noexcept;
 
+    void check_evasions(MoveList &moves) const noexcept;
+
+    void legal_moves(MoveList &moves) const noexcept;
+
+    void legal_captures(MoveList &moves) const noexcept;
+
+    void legal_noncaptures(MoveList &moves) const noexcept;
+
+    void legal_quiet_checks(MoveList &moves) const noexcept;
+
+    void legal_moves_to(MoveList &moves, const Square sq) const noexcept;
+
+    void legal_moves_from(MoveList &moves, const Square sq) const noexcept;
+
+    void legal_moves_of(MoveList &moves, const Piece piece) const noexcept;
+
+    void pseudo_legal_moves(MoveList &moves) const noexcept;
+
+    // Side templated versions for callers that already know whose turn it is
+    // The masks restrict the origin and destination squares before any moves are created
+    template <Side Us>
+    void legal_captures(MoveList &moves,
+                        const Bitboard from_mask = bitboards::AllSquares,
+                        const Bitboard to_mask = bitboards::AllSquares) const noexcept;
+
+    template <Side Us>
+    void legal_noncaptures(MoveList &moves,
+                           const Bitboard from_mask = bitboards::AllSquares,
+                           const Bitboard to_mask = bitboards::AllSquares) const noexcept;
+
+    template <Side Us>
+    void legal_quiet_checks(MoveList &moves) const noexcept;
+
+    template <Side Us>
+    void check_evasions(MoveList &moves) const noexcept;
+
+    template <Side Us>
+    void pseudo_legal_moves(MoveList &moves) const noexcept;
+
+    template <Side Us>
+    [[nodiscard]] bool is_pseudo_legal_move_legal(const Move &move) const noexcept;
+
     [[nodiscard]] constexpr Bitboard passed_pawns() const noexcept {
         return passed_pawns(turn());
     }
@@ -186,188 +370,172 @@ class Position {
     [[nodiscard]] std::uint64_t perft(const int depth) noexcept;
 
     [[nodiscard]] constexpr bool can_castle(const Side s, const MoveType mt) const noexcept {
-        if (s == Side::White) {
-            if (mt == MoveType::ksc) {
-                return castling_[0];
-            } else {
-                return castling_[1];
-            }
-        } else {
-            if (mt == MoveType::ksc) {
-                return castling_[2];
-            } else {
-                return castling_[3];
-            }
-        }
-        return true;
+        return state_.can_castle(s, mt);
     }
 
     [[nodiscard]] std::uint64_t predict_hash(const Move &move) const noexcept;
 
-    [[nodiscard]] Move parse_move(const std::string &str) const {
-        const auto moves = legal_moves();
-        for (const auto &move : moves) {
-            if (static_cast<std::string>(move) == str) {
-                return move;
-            }
-        }
+    // Throws std::invalid_argument if the move isn't legal here
+    [[nodiscard]] Move parse_move(const std::string_view str) const;
 
-        throw std::invalid_argument("Illegal move string");
-    }
+    void makemove(const Move &move) noexcept;
 
+    template <Side Us>
     void makemove(const Move &move) noexcept;
 
-    void makemove(const std::string &str) {
+    // For pseudo-legal search, skips the CheckInfo that makemove() works out for the new position
+    // Everything still works, but the methods that use check_info() are slower until the move is undone
+    void makemove_pseudo(const Move &move) noexcept;
+
+    template <Side Us>
+    void makemove_pseudo(const Move &move) noexcept;
+
+    void makemove(const std::string_view str) {
         const auto move = parse_move(str);
         makemove(move);
     }
 
     void undomove() noexcept;
 
+    // Us is the side that made the move being undone
+    template <Side Us>
+    void undomove() noexcept;
+
     void makenull() noexcept {
+        if (history_.size() == history_.capacity()) {
+            reserve_history();
+        }
+
         history_.push_back(meh{
             hash(),
+            pawn_hash(),
+            material_key(),
             {},
-            ep_,
-            halfmoves(),
+            state_.ep,
             {},
+            state_.halfmove_clock,
         });
 
 #ifndef NO_HASH
-        if (ep_ != squares::OffSq) {
-            hash_ ^= zobrist::ep_key(ep_);
+        if (state_.ep != squares::OffSq) {
+            state_.hash ^= zobrist::ep_key(state_.ep);
         }
-        hash_ ^= zobrist::turn_key();
+        state_.hash ^= zobrist::turn_key();
 #endif
 
-        to_move_ = !to_move_;
-        ep_ = squares::OffSq;
-        halfmove_clock_ = 0;
+        state_.turn = !state_.turn;
+        state_.ep = squares::OffSq;
+        state_.halfmove_clock = 0;
+        check_info_history_.push_back(check_info_);
+        check_info_ = calculate_check_info();
     }
 
     void undonull() noexcept {
-        hash_ = history_.back().hash;
-        ep_ = history_.back().ep;
-        halfmove_clock_ = history_.back().halfmove_clock;
-        to_move_ = !to_move_;
+        state_.hash = history_.back().hash;
+        state_.ep = history_.back().ep;
+        state_.halfmove_clock = history_.back().halfmove_clock;
+        state_.turn = !state_.turn;
         history_.pop_back();
+        check_info_ = check_info_history_.back();
+        check_info_history_.pop_back();
     }
 
     [[nodiscard]] constexpr std::uint64_t calculate_hash() const noexcept {
-        std::uint64_t hash = 0;
-
-        // Turn
-        if (turn() == Side::Black) {
-            hash ^= zobrist::turn_key();
-        }
-
-        // Pieces
-        for (const auto s : {Side::White, Side::Black}) {
-            for (const auto &sq : pieces(s, Piece::Pawn)) {
-                hash ^= zobrist::piece_key(Piece::Pawn, s, sq);
-            }
-            for (const auto &sq : pieces(s, Piece::Knight)) {
-                hash ^= zobrist::piece_key(Piece::Knight, s, sq);
-            }
-            for (const auto &sq : pieces(s, Piece::Bishop)) {
-                hash ^= zobrist::piece_key(Piece::Bishop, s, sq);
-            }
-            for (const auto &sq : pieces(s, Piece::Rook)) {
-                hash ^= zobrist::piece_key(Piece::Rook, s, sq);
-            }
-            for (const auto &sq : pieces(s, Piece::Queen)) {
-                hash ^= zobrist::piece_key(Piece::Queen, s, sq);
-            }
-            for (const auto &sq : pieces(s, Piece::King)) {
-                hash ^= zobrist::piece_key(Piece::King, s, sq);
-            }
-        }
-
-        // Castling
-        if (can_castle(Side::White, MoveType::ksc)) {
-            hash ^= zobrist::castling_key(usKSC);
-        }
-        if (can_castle(Side::White, MoveType::qsc)) {
-            hash ^= zobrist::castling_key(usQSC);
-        }
-        if (can_castle(Side::Black, MoveType::ksc)) {
-            hash ^= zobrist::castling_key(themKSC);
-        }
-        if (can_castle(Side::Black, MoveType::qsc)) {
-            hash ^= zobrist::castling_key(themQSC);
-        }
+        return state_.calculate_hash();
+    }
 
-        // EP
-        if (ep_ != squares::OffSq) {
-            hash ^= zobrist::ep_key(ep_);
-        }
+    [[nodiscard]] constexpr std::uint64_t calculate_pawn_hash() const noexcept {
+        return state_.calculate_pawn_hash();
+    }
 
-        return hash;
+    [[nodiscard]] constexpr std::uint64_t calculate_material_key() const noexcept {
+        return state_.calculate_material_key();
     }
 
     [[nodiscard]] auto &history() const noexcept {
         return history_;
     }
 
+    // Piece::None for squares::OffSq, the mailbox only covers the board
     [[nodiscard]] constexpr Piece piece_on(const Square sq) const noexcept {
-        for (int i = 0; i < 6; ++i) {
-            if (pieces_[i] & Bitboard{sq}) {
-                return Piece(i);
-            }
-        }
-        return Piece::None;
+        const auto idx = static_cast<unsigned>(static_cast<int>(sq));
+        return idx < board_.size() ? board_[idx] : Piece::None;
+    }
+
+    // Only meaningful for occupied squares
+    [[nodiscard]] constexpr Side colour_on(const Square sq) const noexcept {
+        assert(occupied() & sq);
+        return state_.colour_bb[Side::Black] & sq ? Side::Black : Side::White;
     }
 
     [[nodiscard]] constexpr Square ep() const noexcept {
-        return ep_;
+        return state_.ep;
     }
 
     void clear() noexcept {
-        colours_[0].clear();
-        colours_[1].clear();
-        pieces_[0].clear();
-        pieces_[1].clear();
-        pieces_[2].clear();
-        pieces_[3].clear();
-        pieces_[4].clear();
-        pieces_[5].clear();
-        halfmove_clock_ = 0;
-        fullmove_clock_ = 0;
-        ep_ = squares::OffSq;
-        hash_ = 0x0;
-        castling_[0] = false;
-        castling_[1] = false;
-        castling_[2] = false;
-        castling_[3] = false;
-        to_move_ = Side::White;
+        state_ = BoardState{};
+        board_.fill(Piece::None);
         history_.clear();
+        check_info_history_.clear();
+        check_info_ = CheckInfo{};
     }
 
     [[nodiscard]] bool valid() const noexcept;
 
    private:
-    void set(const Square sq, const Side s, const Piece p) noexcept {
-        colours_[s] |= sq;
-        pieces_[p] |= sq;
+    [[nodiscard]] CheckInfo calculate_check_info() const noexcept;
+
+    template <Side Us>
+    [[nodiscard]] CheckInfo calculate_check_info() const noexcept;
+
+    template <Side Us>
+    [[nodiscard]] CheckSquares calculate_check_squares() const noexcept;
+
+    // Grows the history to at least history_capacity, so a search doesn't reallocate it move by move
+    void reserve_history() noexcept;
+
+    // Everything makemove() does except working out the check info
+    template <Side Us>
+    void apply_move(const Move &move) noexcept;
+
+    // Starts a new game from the state, keeping whatever history capacity is already there
+    void set_state(const BoardState &state) noexcept {
+        state_ = state;
+        board_.fill(Piece::None);
+        for (int i = 0; i < 6; ++i) {
+            for (const auto &sq : state_.piece_bb[i]) {
+                board_[static_cast<int>(sq)] = Piece(i);
+            }
+        }
+        history_.clear();
+        check_info_history_.clear();
+        check_info_ = calculate_check_info();
+        assert(valid());
     }
 
+    // Everything makemove() can't recover from the move itself, packed so two fit in a cache line
     struct meh {
         std::uint64_t hash = 0;
+        std::uint64_t pawn_hash = 0;
+        std::uint64_t material_key = 0;
         Move move;
         Square ep;
-        std::size_t halfmove_clock = 0;
-        bool castling[4] = {};
+        std::uint8_t castling = 0;
+        std::uint16_t halfmove_clock = 0;
     };
 
-    Bitboard colours_[2] = {};
-    Bitboard pieces_[6] = {};
-    std::size_t halfmove_clock_ = 0;
-    std::size_t fullmove_clock_ = 0;
-    Square ep_ = squares::OffSq;
-    std::uint64_t hash_ = 0;
-    bool castling_[4] = {};
-    Side to_move_ = Side::White;
+    static_assert(sizeof(meh) == 32);
+
+    // Reserved by the first move made, so makemove() doesn't reallocate during a search
+    static constexpr std::size_t history_capacity = 1024;
+
+    BoardState state_;
+    std::array<Piece, 64> board_ = make_empty_board();
     std::vector<meh> history_;
+    // Empty after makemove_pseudo()
+    std::optional<CheckInfo> check_info_;
+    // The check info before each entry in history_, so undoing doesn't recompute it
+    std::vector<std::optional<CheckInfo>> check_info_history_;
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Position &pos) noexcept {
@@ -0,0 +1,57 @@
+#ifndef LIBCHESS_RELATIVE_HPP
+#define LIBCHESS_RELATIVE_HPP
+
+#include "bitboard.hpp"
+#include "side.hpp"
+#include "square.hpp"
+
+namespace libchess {
+
+// Side relative helpers, in side templated code these all resolve at compile time
+
+template <Side S, typename T>
+[[nodiscard]] constexpr T forward(const T &x) noexcept {
+    if constexpr (S == Side::White) {
+        return x.north();
+    } else {
+        return x.south();
+    }
+}
+
+template <Side S, typename T>
+[[nodiscard]] constexpr T backward(const T &x) noexcept {
+    if constexpr (S == Side::White) {
+        return x.south();
+    } else {
+        return x.north();
+    }
+}
+
+template <Side S>
+[[nodiscard]] constexpr Bitboard relative_rank(const int n) noexcept {
+    return bitboards::ranks[S == Side::White ? n : 7 - n];
+}
+
+template <Side S>
+[[nodiscard]] constexpr Square relative_square(const Square sq) noexcept {
+    return S == Side::White ? sq : sq.flip();
+}
+
+template <Side S>
+[[nodiscard]] constexpr Bitboard pawn_attacks(const Bitboard &pawns) noexcept {
+    return forward<S>(pawns).east() | forward<S>(pawns).west();
+}
+
+static_assert(forward<Side::White>(bitboards::Rank2) == bitboards::Rank3);
+static_assert(forward<Side::Black>(bitboards::Rank7) == bitboards::Rank6);
+static_assert(backward<Side::White>(squares::A2) == squares::A1);
+static_assert(backward<Side::Black>(squares::A7) == squares::A8);
+static_assert(relative_rank<Side::White>(6) == bitboards::Rank7);
+static_assert(relative_rank<Side::Black>(6) == bitboards::Rank2);
+static_assert(relative_square<Side::White>(squares::E1) == squares::E1);
+static_assert(relative_square<Side::Black>(squares::E1) == squares::E8);
+static_assert(pawn_attacks<Side::White>(Bitboard{squares::D4}) == (Bitboard{squares::C5} | Bitboard{squares::E5}));
+
+}  // namespace libchess
+
+#endif
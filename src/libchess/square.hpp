@@ -1,6 +1,7 @@
 #ifndef LIBCHESS_SQUARE_HPP
 #define LIBCHESS_SQUARE_HPP
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <ostream>
@@ -42,12 +43,7 @@ class Square {
         return data_;
     }
 
-    [[nodiscard]] explicit operator std::string() const noexcept {
-        std::string str;
-        str += static_cast<char>('a' + file());
-        str += static_cast<char>('1' + rank());
-        return str;
-    }
+    [[nodiscard]] explicit operator std::string() const noexcept;
 
     [[nodiscard]] constexpr explicit operator unsigned int() const noexcept {
         return data_;
@@ -93,8 +89,28 @@ class Square {
     std::uint8_t data_ = 0xFF;
 };
 
+// Writes the square into the buffer without a terminator, returns one past the last character written
+constexpr char *write_uci(char *out, const Square sq) noexcept {
+    *out++ = static_cast<char>('a' + sq.file());
+    *out++ = static_cast<char>('1' + sq.rank());
+    return out;
+}
+
+// Null terminated
+[[nodiscard]] constexpr std::array<char, 3> to_uci(const Square sq) noexcept {
+    std::array<char, 3> str = {};
+    write_uci(str.data(), sq);
+    return str;
+}
+
+inline Square::operator std::string() const noexcept {
+    char buf[2];
+    return std::string(buf, write_uci(buf, *this));
+}
+
 inline std::ostream &operator<<(std::ostream &os, const Square &sq) noexcept {
-    os << static_cast<std::string>(sq);
+    char buf[2];
+    os.write(buf, write_uci(buf, sq) - buf);
     return os;
 }
 
@@ -1,12 +1,13 @@
 #ifndef LIBCHESS_VALIDATE_HPP
 #define LIBCHESS_VALIDATE_HPP
 
-#include <string>
+#include <string_view>
+#include "fen.hpp"
 
 namespace libchess::validate {
 
-[[nodiscard]] bool fen(const std::string &fen) {
-    return true;
+[[nodiscard]] inline bool fen(const std::string_view fen) noexcept {
+    return parse_fen(fen).error == FenError::None;
 }
 
 }  // namespace libchess::validate
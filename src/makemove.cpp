@@ -1,51 +1,149 @@
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 void Position::makemove(const Move &move) noexcept {
-    const auto us = turn();
-    const auto them = !turn();
+    if (turn() == Side::White) {
+        makemove<Side::White>(move);
+    } else {
+        makemove<Side::Black>(move);
+    }
+}
+
+void Position::makemove_pseudo(const Move &move) noexcept {
+    if (turn() == Side::White) {
+        makemove_pseudo<Side::White>(move);
+    } else {
+        makemove_pseudo<Side::Black>(move);
+    }
+}
+
+template <Side Us>
+void Position::makemove(const Move &move) noexcept {
+    apply_move<Us>(move);
+    check_info_history_.push_back(check_info_);
+    check_info_ = calculate_check_info<!Us>();
+    assert(valid());
+}
+
+// Leaves the check info empty, so pseudo-legal search doesn't pay for pins and king danger at every node
+template <Side Us>
+void Position::makemove_pseudo(const Move &move) noexcept {
+    apply_move<Us>(move);
+    check_info_history_.push_back(check_info_);
+    check_info_.reset();
+    assert(valid());
+}
+
+template <Side Us>
+void Position::apply_move(const Move &move) noexcept {
+    [[maybe_unused]] constexpr auto them = !Us;
+
+    const auto to = move.to();
+    const auto from = move.from();
+    const auto piece = move.piece();
+
+    assert(piece_on(from) == piece);
+    assert(move.captured() == Piece::None || move.type() == MoveType::enpassant || piece_on(to) == move.captured());
+
+    switch (move.type()) {
+        case MoveType::ksc:
+            assert(Us == Side::White ? piece_on(squares::F1) == Piece::None : piece_on(squares::F8) == Piece::None);
+            assert(Us == Side::White ? piece_on(squares::G1) == Piece::None : piece_on(squares::G8) == Piece::None);
+            assert(Us == Side::White ? piece_on(squares::H1) == Piece::Rook : piece_on(squares::H8) == Piece::Rook);
+            assert(Us == Side::White ? !square_attacked(squares::E1, them) : !square_attacked(squares::E8, them));
+            assert(Us == Side::White ? !square_attacked(squares::F1, them) : !square_attacked(squares::F8, them));
+            assert(Us == Side::White ? !square_attacked(squares::G1, them) : !square_attacked(squares::G8, them));
+            board_[static_cast<int>(ksc_rook_fr[Us])] = Piece::None;
+            board_[static_cast<int>(ksc_rook_to[Us])] = Piece::Rook;
+            break;
+        case MoveType::qsc:
+            assert(Us == Side::White ? piece_on(squares::D1) == Piece::None : piece_on(squares::D8) == Piece::None);
+            assert(Us == Side::White ? piece_on(squares::C1) == Piece::None : piece_on(squares::C8) == Piece::None);
+            assert(Us == Side::White ? piece_on(squares::B1) == Piece::None : piece_on(squares::B8) == Piece::None);
+            assert(Us == Side::White ? piece_on(squares::A1) == Piece::Rook : piece_on(squares::A8) == Piece::Rook);
+            assert(Us == Side::White ? !square_attacked(squares::E1, them) : !square_attacked(squares::E8, them));
+            assert(Us == Side::White ? !square_attacked(squares::D1, them) : !square_attacked(squares::D8, them));
+            assert(Us == Side::White ? !square_attacked(squares::C1, them) : !square_attacked(squares::C8, them));
+            board_[static_cast<int>(qsc_rook_fr[Us])] = Piece::None;
+            board_[static_cast<int>(qsc_rook_to[Us])] = Piece::Rook;
+            break;
+        case MoveType::enpassant:
+            board_[static_cast<int>(backward<Us>(to))] = Piece::None;
+            break;
+        case MoveType::Normal:
+        case MoveType::Capture:
+        case MoveType::Double:
+        case MoveType::promo:
+        case MoveType::promo_capture:
+        default:
+            break;
+    }
+
+    // Add to history
+    if (history_.size() == history_.capacity()) {
+        reserve_history();
+    }
+    history_.push_back(meh{state_.hash, state_.pawn_hash, state_.material_key, move, state_.ep, state_.castling, state_.halfmove_clock});
+
+    // Moving onto the square overwrites anything captured there
+    board_[static_cast<int>(from)] = Piece::None;
+    board_[static_cast<int>(to)] = move.is_promoting() ? move.promotion() : piece;
+
+    state_.makemove<Us>(move);
+}
+
+template <Side Us>
+void BoardState::makemove(const Move &move) noexcept {
+    constexpr auto them = !Us;
+
     const auto to = move.to();
     const auto from = move.from();
     const auto piece = move.piece();
     const auto captured = move.captured();
     const auto promo = move.promotion();
-    const auto hash_old = hash_;
-    const auto ep_old = ep_;
-    const auto halfmove_clock_old = halfmove_clock_;
+    [[maybe_unused]] const auto ep_old = ep;
 
+    assert(turn == Us);
     assert(to != from);
     assert(piece != Piece::None);
     assert(captured != Piece::King);
     assert(promo != Piece::Pawn);
     assert(promo != Piece::King);
-    assert(piece_on(move.from()) == piece);
+    assert(pieces(Us, piece) & from);
 
     // Remove piece
-    colours_[us] ^= move.from();
-    pieces_[piece] ^= move.from();
+    colour_bb[Us] ^= from;
+    piece_bb[piece] ^= from;
 
     // Add piece
-    colours_[us] ^= move.to();
-    pieces_[piece] ^= move.to();
+    colour_bb[Us] ^= to;
+    piece_bb[piece] ^= to;
 
     // Fullmoves
-    fullmove_clock_ += us == Side::Black;
+    if constexpr (Us == Side::Black) {
+        fullmove_clock++;
+    }
 
 #ifndef NO_HASH
-    hash_ ^= zobrist::turn_key();
-    hash_ ^= zobrist::piece_key(piece, us, move.from());
-    hash_ ^= zobrist::piece_key(piece, us, move.to());
-    if (ep_ != squares::OffSq) {
-        hash_ ^= zobrist::ep_key(ep_);
+    hash ^= zobrist::turn_key();
+    hash ^= zobrist::piece_key(piece, Us, from);
+    hash ^= zobrist::piece_key(piece, Us, to);
+    if (ep != squares::OffSq) {
+        hash ^= zobrist::ep_key(ep);
+    }
+    if (piece == Piece::Pawn) {
+        pawn_hash ^= zobrist::piece_key(Piece::Pawn, Us, from);
+        pawn_hash ^= zobrist::piece_key(Piece::Pawn, Us, to);
     }
 #endif
 
     // Remove ep
-    ep_ = squares::OffSq;
+    ep = squares::OffSq;
 
     // Increment halfmove clock
-    halfmove_clock_++;
+    halfmove_clock++;
 
     switch (move.type()) {
         case MoveType::Normal:
@@ -53,36 +151,40 @@ void Position::makemove(const Move &move) noexcept {
             assert(promo == Piece::None);
 
             if (piece == Piece::Pawn) {
-                halfmove_clock_ = 0;
+                halfmove_clock = 0;
             }
             break;
         case MoveType::Capture:
             assert(captured != Piece::None);
             assert(promo == Piece::None);
 
-            halfmove_clock_ = 0;
+            halfmove_clock = 0;
+
+            // Remove the captured piece
+            piece_bb[captured] ^= to;
+            colour_bb[them] ^= to;
 
 #ifndef NO_HASH
-            hash_ ^= zobrist::piece_key(captured, them, move.to());
+            hash ^= zobrist::piece_key(captured, them, to);
+            if (captured == Piece::Pawn) {
+                pawn_hash ^= zobrist::piece_key(Piece::Pawn, them, to);
+            }
+            material_key ^= zobrist::material_key(captured, them, pieces(them, captured).count());
 #endif
-
-            // Remove the captured piece
-            pieces_[captured] ^= move.to();
-            colours_[them] ^= move.to();
             break;
         case MoveType::Double:
             assert(piece == Piece::Pawn);
             assert(captured == Piece::None);
             assert(promo == Piece::None);
             assert(to.file() == from.file());
-            assert((us == Side::White && move.to().rank() == 3) || (us == Side::Black && move.to().rank() == 4));
-            assert((us == Side::White && move.from().rank() == 1) || (us == Side::Black && move.from().rank() == 6));
+            assert((Us == Side::White && to.rank() == 3) || (Us == Side::Black && to.rank() == 4));
+            assert((Us == Side::White && from.rank() == 1) || (Us == Side::Black && from.rank() == 6));
 
-            halfmove_clock_ = 0;
-            ep_ = us == Side::White ? to.south() : to.north();
+            halfmove_clock = 0;
+            ep = backward<Us>(to);
 
 #ifndef NO_HASH
-            hash_ ^= zobrist::ep_key(ep_);
+            hash ^= zobrist::ep_key(ep);
 #endif
             break;
         case MoveType::enpassant:
@@ -90,166 +192,133 @@ void Position::makemove(const Move &move) noexcept {
             assert(captured == Piece::Pawn);
             assert(promo == Piece::None);
             assert(to.file() == ep_old.file());
-            assert((us == Side::White && move.to().rank() == 5) || (us == Side::Black && move.to().rank() == 2));
-            assert((us == Side::White && move.from().rank() == 4) || (us == Side::Black && move.from().rank() == 3));
+            assert((Us == Side::White && to.rank() == 5) || (Us == Side::Black && to.rank() == 2));
+            assert((Us == Side::White && from.rank() == 4) || (Us == Side::Black && from.rank() == 3));
             assert(to.file() - from.file() == 1 || from.file() - to.file() == 1);
 
-            halfmove_clock_ = 0;
+            halfmove_clock = 0;
 
             // Remove the captured pawn
-            if (turn() == Side::White) {
-                pieces_[Piece::Pawn] ^= move.to().south();
-                colours_[Side::Black] ^= move.to().south();
+            piece_bb[Piece::Pawn] ^= backward<Us>(to);
+            colour_bb[them] ^= backward<Us>(to);
 #ifndef NO_HASH
-                hash_ ^= zobrist::piece_key(Piece::Pawn, them, move.to().south());
+            hash ^= zobrist::piece_key(Piece::Pawn, them, backward<Us>(to));
+            pawn_hash ^= zobrist::piece_key(Piece::Pawn, them, backward<Us>(to));
+            material_key ^= zobrist::material_key(Piece::Pawn, them, pieces(them, Piece::Pawn).count());
 #endif
-            } else {
-                pieces_[Piece::Pawn] ^= move.to().north();
-                colours_[Side::White] ^= move.to().north();
-#ifndef NO_HASH
-                hash_ ^= zobrist::piece_key(Piece::Pawn, them, move.to().north());
-#endif
-            }
             break;
         case MoveType::ksc:
             assert(piece == Piece::King);
             assert(captured == Piece::None);
             assert(promo == Piece::None);
-            assert(can_castle(us, MoveType::ksc));
-            assert(us == Side::White ? move.from() == squares::E1 : move.from() == squares::E8);
-            assert(us == Side::White ? move.to() == squares::G1 : move.to() == squares::G8);
-            assert(us == Side::White ? piece_on(squares::E1) == Piece::None : piece_on(squares::E8) == Piece::None);
-            assert(us == Side::White ? piece_on(squares::F1) == Piece::None : piece_on(squares::F8) == Piece::None);
-            assert(us == Side::White ? piece_on(squares::G1) == Piece::King : piece_on(squares::G8) == Piece::King);
-            assert(us == Side::White ? piece_on(squares::H1) == Piece::Rook : piece_on(squares::H8) == Piece::Rook);
-            assert(us == Side::White ? !square_attacked(squares::E1, them) : !square_attacked(squares::E8, them));
-            assert(us == Side::White ? !square_attacked(squares::F1, them) : !square_attacked(squares::F8, them));
-            assert(us == Side::White ? !square_attacked(squares::G1, them) : !square_attacked(squares::G8, them));
+            assert(can_castle(Us, MoveType::ksc));
+            assert(Us == Side::White ? from == squares::E1 : from == squares::E8);
+            assert(Us == Side::White ? to == squares::G1 : to == squares::G8);
 
 #ifndef NO_HASH
-            hash_ ^= zobrist::piece_key(Piece::Rook, us, ksc_rook_fr[us]);
-            hash_ ^= zobrist::piece_key(Piece::Rook, us, ksc_rook_to[us]);
+            hash ^= zobrist::piece_key(Piece::Rook, Us, ksc_rook_fr[Us]);
+            hash ^= zobrist::piece_key(Piece::Rook, Us, ksc_rook_to[Us]);
 #endif
 
             // Remove the rook
-            colours_[us] ^= ksc_rook_fr[us];
-            pieces_[Piece::Rook] ^= ksc_rook_fr[us];
+            colour_bb[Us] ^= ksc_rook_fr[Us];
+            piece_bb[Piece::Rook] ^= ksc_rook_fr[Us];
             // Add the rook
-            colours_[us] ^= ksc_rook_to[us];
-            pieces_[Piece::Rook] ^= ksc_rook_to[us];
+            colour_bb[Us] ^= ksc_rook_to[Us];
+            piece_bb[Piece::Rook] ^= ksc_rook_to[Us];
             break;
         case MoveType::qsc:
             assert(piece == Piece::King);
             assert(captured == Piece::None);
             assert(promo == Piece::None);
-            assert(can_castle(us, MoveType::qsc));
-            assert(us == Side::White ? move.from() == squares::E1 : move.from() == squares::E8);
-            assert(us == Side::White ? move.to() == squares::C1 : move.to() == squares::C8);
-            assert(us == Side::White ? piece_on(squares::E1) == Piece::None : piece_on(squares::E8) == Piece::None);
-            assert(us == Side::White ? piece_on(squares::D1) == Piece::None : piece_on(squares::D8) == Piece::None);
-            assert(us == Side::White ? piece_on(squares::C1) == Piece::King : piece_on(squares::C8) == Piece::King);
-            assert(us == Side::White ? piece_on(squares::B1) == Piece::None : piece_on(squares::B8) == Piece::None);
-            assert(us == Side::White ? piece_on(squares::A1) == Piece::Rook : piece_on(squares::A8) == Piece::Rook);
-            assert(us == Side::White ? !square_attacked(squares::E1, them) : !square_attacked(squares::E8, them));
-            assert(us == Side::White ? !square_attacked(squares::D1, them) : !square_attacked(squares::D8, them));
-            assert(us == Side::White ? !square_attacked(squares::C1, them) : !square_attacked(squares::C8, them));
+            assert(can_castle(Us, MoveType::qsc));
+            assert(Us == Side::White ? from == squares::E1 : from == squares::E8);
+            assert(Us == Side::White ? to == squares::C1 : to == squares::C8);
 
 #ifndef NO_HASH
-            hash_ ^= zobrist::piece_key(Piece::Rook, us, qsc_rook_fr[us]);
-            hash_ ^= zobrist::piece_key(Piece::Rook, us, qsc_rook_to[us]);
+            hash ^= zobrist::piece_key(Piece::Rook, Us, qsc_rook_fr[Us]);
+            hash ^= zobrist::piece_key(Piece::Rook, Us, qsc_rook_to[Us]);
 #endif
 
             // Remove the rook
-            colours_[us] ^= qsc_rook_fr[us];
-            pieces_[Piece::Rook] ^= qsc_rook_fr[us];
+            colour_bb[Us] ^= qsc_rook_fr[Us];
+            piece_bb[Piece::Rook] ^= qsc_rook_fr[Us];
             // Add the rook
-            colours_[us] ^= qsc_rook_to[us];
-            pieces_[Piece::Rook] ^= qsc_rook_to[us];
+            colour_bb[Us] ^= qsc_rook_to[Us];
+            piece_bb[Piece::Rook] ^= qsc_rook_to[Us];
             break;
         case MoveType::promo:
             assert(piece == Piece::Pawn);
             assert(captured == Piece::None);
             assert(promo != Piece::None);
-            assert(move.to().file() == move.from().file());
-            assert((us == Side::White && move.to().rank() == 7) || (us == Side::Black && move.to().rank() == 0));
-            assert((us == Side::White && move.from().rank() == 6) || (us == Side::Black && move.from().rank() == 1));
+            assert(to.file() == from.file());
+            assert((Us == Side::White && to.rank() == 7) || (Us == Side::Black && to.rank() == 0));
+            assert((Us == Side::White && from.rank() == 6) || (Us == Side::Black && from.rank() == 1));
 
-            halfmove_clock_ = 0;
+            halfmove_clock = 0;
+
+            // Replace pawn with piece
+            piece_bb[Piece::Pawn] ^= to;
+            piece_bb[promo] ^= to;
 
 #ifndef NO_HASH
-            hash_ ^= zobrist::piece_key(Piece::Pawn, us, move.to());
-            hash_ ^= zobrist::piece_key(promo, us, move.to());
+            hash ^= zobrist::piece_key(Piece::Pawn, Us, to);
+            hash ^= zobrist::piece_key(promo, Us, to);
+            pawn_hash ^= zobrist::piece_key(Piece::Pawn, Us, to);
+            material_key ^= zobrist::material_key(Piece::Pawn, Us, pieces(Us, Piece::Pawn).count());
+            material_key ^= zobrist::material_key(promo, Us, pieces(Us, promo).count() - 1);
 #endif
-
-            // Replace pawn with piece
-            pieces_[Piece::Pawn] ^= move.to();
-            pieces_[promo] ^= move.to();
             break;
         case MoveType::promo_capture:
             assert(piece == Piece::Pawn);
             assert(captured != Piece::None);
             assert(promo != Piece::None);
-            assert(move.to().file() != move.from().file());
-            assert((us == Side::White && move.to().rank() == 7) || (us == Side::Black && move.to().rank() == 0));
-            assert((us == Side::White && move.from().rank() == 6) || (us == Side::Black && move.from().rank() == 1));
-
-            halfmove_clock_ = 0;
+            assert(to.file() != from.file());
+            assert((Us == Side::White && to.rank() == 7) || (Us == Side::Black && to.rank() == 0));
+            assert((Us == Side::White && from.rank() == 6) || (Us == Side::Black && from.rank() == 1));
 
-#ifndef NO_HASH
-            hash_ ^= zobrist::piece_key(captured, them, move.to());
-            hash_ ^= zobrist::piece_key(Piece::Pawn, us, move.to());
-            hash_ ^= zobrist::piece_key(promo, us, move.to());
-#endif
+            halfmove_clock = 0;
 
             // Replace pawn with piece
-            pieces_[Piece::Pawn] ^= move.to();
-            pieces_[promo] ^= move.to();
+            piece_bb[Piece::Pawn] ^= to;
+            piece_bb[promo] ^= to;
             // Remove the captured piece
-            pieces_[captured] ^= move.to();
-            colours_[them] ^= move.to();
+            piece_bb[captured] ^= to;
+            colour_bb[them] ^= to;
+
+#ifndef NO_HASH
+            hash ^= zobrist::piece_key(captured, them, to);
+            hash ^= zobrist::piece_key(Piece::Pawn, Us, to);
+            hash ^= zobrist::piece_key(promo, Us, to);
+            pawn_hash ^= zobrist::piece_key(Piece::Pawn, Us, to);
+            material_key ^= zobrist::material_key(captured, them, pieces(them, captured).count());
+            material_key ^= zobrist::material_key(Piece::Pawn, Us, pieces(Us, Piece::Pawn).count());
+            material_key ^= zobrist::material_key(promo, Us, pieces(Us, promo).count() - 1);
+#endif
             break;
         default:
             abort();
     }
 
-#ifndef NO_HASH
-    const bool castling_old[] = {
-        castling_[0],
-        castling_[1],
-        castling_[2],
-        castling_[3],
-    };
-#endif
-
-    // Add to history
-    history_.push_back(
-        meh{hash_old, move, ep_old, halfmove_clock_old, {castling_[0], castling_[1], castling_[2], castling_[3]}});
-
     // Castling permissions
-    castling_[usKSC] &= !(to == squares::H1 || from == squares::E1 || from == squares::H1);
-    castling_[usQSC] &= !(to == squares::A1 || from == squares::E1 || from == squares::A1);
-    castling_[themKSC] &= !(to == squares::H8 || from == squares::E8 || from == squares::H8);
-    castling_[themQSC] &= !(to == squares::A8 || from == squares::E8 || from == squares::A8);
+    [[maybe_unused]] const auto castling_old = castling;
+    castling &= castling_kept[static_cast<int>(from)] & castling_kept[static_cast<int>(to)];
 
 #ifndef NO_HASH
-    if (castling_[usKSC] != castling_old[usKSC]) {
-        hash_ ^= zobrist::castling_key(usKSC);
-    }
-    if (castling_[usQSC] != castling_old[usQSC]) {
-        hash_ ^= zobrist::castling_key(usQSC);
-    }
-    if (castling_[themKSC] != castling_old[themKSC]) {
-        hash_ ^= zobrist::castling_key(themKSC);
-    }
-    if (castling_[themQSC] != castling_old[themQSC]) {
-        hash_ ^= zobrist::castling_key(themQSC);
-    }
+    hash ^= zobrist::castling_rights_key(castling_old ^ castling);
 #endif
 
     // Swap sides
-    to_move_ = !to_move_;
-
-    assert(valid());
+    turn = them;
 }
 
+template void Position::makemove<Side::White>(const Move &move) noexcept;
+template void Position::makemove<Side::Black>(const Move &move) noexcept;
+
+template void Position::makemove_pseudo<Side::White>(const Move &move) noexcept;
+template void Position::makemove_pseudo<Side::Black>(const Move &move) noexcept;
+
+template void BoardState::makemove<Side::White>(const Move &move) noexcept;
+template void BoardState::makemove<Side::Black>(const Move &move) noexcept;
+
 }  // namespace libchess
@@ -3,6 +3,12 @@
 #include <cassert>
 #include <cstdint>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBCHESS_PEXT
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace libchess::movegen {
 
 constexpr std::pair<std::uint64_t, int> bishop_stuff[64] = {
@@ -264,7 +270,44 @@ constexpr auto bishop_masks = calculate_bishop_masks();
 constexpr auto rook_masks = generate_rook_masks();
 constexpr auto king_masks = calculate_king_masks();
 
-std::array<std::uint64_t, 88772> generate_magic_moves() {
+[[nodiscard]] bool fast_pext() noexcept {
+#ifdef LIBCHESS_PEXT
+    __builtin_cpu_init();
+
+    if (!__builtin_cpu_supports("bmi2")) {
+        return false;
+    }
+
+    // PEXT is microcoded on AMD before Zen 3 and much slower than a magic multiply
+    if (__builtin_cpu_is("amd")) {
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const unsigned int family = ((eax >> 8) & 0xF) + ((eax >> 20) & 0xFF);
+        return family >= 0x19;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+const bool use_pext = fast_pext();
+
+[[nodiscard]] constexpr int magic_bishop_index(const int sq, const Bitboard &occ) {
+    return bishop_stuff[sq].second + (((occ & bishop_masks[sq]).value() * bishop_stuff[sq].first) >> 55);
+}
+
+[[nodiscard]] constexpr int magic_rook_index(const int sq, const Bitboard &occ) {
+    return rook_stuff[sq].second + (((occ & rook_masks[sq]).value() * rook_stuff[sq].first) >> 52);
+}
+
+[[nodiscard]] constexpr std::array<std::uint64_t, 88772> generate_magic_moves() {
     std::array<std::uint64_t, 88772> result = {};
 
     for (int i = 0; i < 64; ++i) {
@@ -277,40 +320,142 @@ std::array<std::uint64_t, 88772> generate_magic_moves() {
         // Bishops
         perm.clear();
         do {
-            std::uint64_t *index =
-                (std::uint64_t *)(result.data() + bishop_stuff[i].second +
-                                  (((perm & bishop_masks[i]).value() * bishop_stuff[i].first) >> 55));
-            *index = calculate_bishop_moves(sq, perm).value();
+            result[magic_bishop_index(i, perm)] = calculate_bishop_moves(sq, perm).value();
         } while ((perm = permute(bishop_masks[i], perm)));
 
         // Rooks
         perm.clear();
         do {
-            std::uint64_t *index = (std::uint64_t *)(result.data() + rook_stuff[i].second +
-                                                     (((perm & rook_masks[i]).value() * rook_stuff[i].first) >> 52));
-            *index = calculate_rook_moves(sq, perm).value();
+            result[magic_rook_index(i, perm)] = calculate_rook_moves(sq, perm).value();
         } while ((perm = permute(rook_masks[i], perm)));
     }
 
     return result;
 }
 
-const auto magic_moves = generate_magic_moves();
+// The slider tables are built at compile time so they live in read-only data and cost nothing at startup
+constexpr auto magic_moves = generate_magic_moves();
+
+[[nodiscard]] constexpr std::array<int, 64> calculate_pext_offsets(const std::array<Bitboard, 64> &masks,
+                                                                   const int start) {
+    std::array<int, 64> result = {};
+    int offset = start;
+    for (int i = 0; i < 64; ++i) {
+        result[i] = offset;
+        offset += 1 << masks[i].count();
+    }
+    return result;
+}
+
+constexpr auto pext_bishop_offsets = calculate_pext_offsets(bishop_masks, 0);
+constexpr auto pext_rook_offsets = calculate_pext_offsets(rook_masks, 5248);
+
+static_assert(pext_bishop_offsets[63] + (1 << bishop_masks[63].count()) == 5248);
+static_assert(pext_rook_offsets[63] + (1 << rook_masks[63].count()) == 5248 + 102400);
+
+[[nodiscard]] constexpr std::array<std::uint64_t, 107648> generate_pext_moves() {
+    std::array<std::uint64_t, 107648> result = {};
+
+    // permute() visits the subsets of a mask in the same order that PEXT indexes them
+    // The attack sets themselves are copied from the magic table
+    for (int i = 0; i < 64; ++i) {
+        Bitboard perm;
+        int idx;
+
+        // Bishops
+        idx = 0;
+        perm.clear();
+        do {
+            result[pext_bishop_offsets[i] + idx] = magic_moves[magic_bishop_index(i, perm)];
+            idx++;
+        } while ((perm = permute(bishop_masks[i], perm)));
+
+        // Rooks
+        idx = 0;
+        perm.clear();
+        do {
+            result[pext_rook_offsets[i] + idx] = magic_moves[magic_rook_index(i, perm)];
+            idx++;
+        } while ((perm = permute(rook_masks[i], perm)));
+    }
+
+    return result;
+}
+
+constexpr auto pext_moves = generate_pext_moves();
 
 Bitboard knight_moves(const Square sq) {
     return knight_masks[static_cast<int>(sq)];
 }
 
-Bitboard bishop_moves(const Square sq, const Bitboard &occ) {
+#ifdef LIBCHESS_PEXT
+[[nodiscard]] __attribute__((target("bmi2"))) Bitboard bishop_moves_pext(const Square sq, const Bitboard &occ) {
     const int idx = static_cast<int>(sq);
-    return Bitboard(*(magic_moves.data() + bishop_stuff[idx].second +
-                      (((occ & bishop_masks[idx]).value() * bishop_stuff[idx].first) >> 55)));
+    return Bitboard(pext_moves[pext_bishop_offsets[idx] + _pext_u64(occ.value(), bishop_masks[idx].value())]);
 }
 
-Bitboard rook_moves(const Square sq, const Bitboard &occ) {
+[[nodiscard]] __attribute__((target("bmi2"))) Bitboard rook_moves_pext(const Square sq, const Bitboard &occ) {
     const int idx = static_cast<int>(sq);
-    return Bitboard(*(magic_moves.data() + rook_stuff[idx].second +
-                      (((occ & rook_masks[idx]).value() * rook_stuff[idx].first) >> 52)));
+    return Bitboard(pext_moves[pext_rook_offsets[idx] + _pext_u64(occ.value(), rook_masks[idx].value())]);
+}
+#endif
+
+SliderBackend slider_backend() noexcept {
+    return use_pext ? SliderBackend::Pext : SliderBackend::Magic;
+}
+
+Bitboard bishop_moves(const Square sq, const Bitboard &occ) {
+#ifdef LIBCHESS_PEXT
+    if (use_pext) {
+        return bishop_moves_pext(sq, occ);
+    }
+#endif
+    return Bitboard(magic_moves[magic_bishop_index(static_cast<int>(sq), occ)]);
+}
+
+Bitboard rook_moves(const Square sq, const Bitboard &occ) {
+#ifdef LIBCHESS_PEXT
+    if (use_pext) {
+        return rook_moves_pext(sq, occ);
+    }
+#endif
+    return Bitboard(magic_moves[magic_rook_index(static_cast<int>(sq), occ)]);
+}
+
+bool slider_backend_supported(const SliderBackend backend) noexcept {
+    switch (backend) {
+        case SliderBackend::Magic:
+            return true;
+        case SliderBackend::Pext:
+#ifdef LIBCHESS_PEXT
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("bmi2");
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+Bitboard bishop_moves(const SliderBackend backend, const Square sq, const Bitboard &occ) {
+    assert(slider_backend_supported(backend));
+#ifdef LIBCHESS_PEXT
+    if (backend == SliderBackend::Pext) {
+        return bishop_moves_pext(sq, occ);
+    }
+#endif
+    return Bitboard(magic_moves[magic_bishop_index(static_cast<int>(sq), occ)]);
+}
+
+Bitboard rook_moves(const SliderBackend backend, const Square sq, const Bitboard &occ) {
+    assert(slider_backend_supported(backend));
+#ifdef LIBCHESS_PEXT
+    if (backend == SliderBackend::Pext) {
+        return rook_moves_pext(sq, occ);
+    }
+#endif
+    return Bitboard(magic_moves[magic_rook_index(static_cast<int>(sq), occ)]);
 }
 
 Bitboard queen_moves(const Square sq, const Bitboard &occ) {
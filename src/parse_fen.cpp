@@ -0,0 +1,270 @@
+#include <cstdint>
+#include <string_view>
+#include "libchess/fen.hpp"
+#include "libchess/movegen.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+namespace {
+
+constexpr std::string_view startpos_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// Fields are split on runs of spaces, an empty view means there's nothing left
+[[nodiscard]] std::string_view next_field(const std::string_view str, std::size_t &pos) noexcept {
+    while (pos < str.size() && str[pos] == ' ') {
+        pos++;
+    }
+    const auto start = pos;
+    while (pos < str.size() && str[pos] != ' ') {
+        pos++;
+    }
+    return str.substr(start, pos - start);
+}
+
+// Digits only and no larger than the clocks can hold
+[[nodiscard]] constexpr bool parse_clock(const std::string_view str, std::uint16_t &value) noexcept {
+    if (str.empty() || str.size() > 5) {
+        return false;
+    }
+    std::uint32_t n = 0;
+    for (const auto c : str) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        n = 10 * n + (c - '0');
+    }
+    if (n > 0xFFFF) {
+        return false;
+    }
+    value = static_cast<std::uint16_t>(n);
+    return true;
+}
+
+[[nodiscard]] constexpr bool parse_piece(const char c, Side &s, Piece &p) noexcept {
+    switch (c) {
+        case 'P':
+        case 'p':
+            p = Piece::Pawn;
+            break;
+        case 'N':
+        case 'n':
+            p = Piece::Knight;
+            break;
+        case 'B':
+        case 'b':
+            p = Piece::Bishop;
+            break;
+        case 'R':
+        case 'r':
+            p = Piece::Rook;
+            break;
+        case 'Q':
+        case 'q':
+            p = Piece::Queen;
+            break;
+        case 'K':
+        case 'k':
+            p = Piece::King;
+            break;
+        default:
+            return false;
+    }
+    s = c < 'a' ? Side::White : Side::Black;
+    return true;
+}
+
+[[nodiscard]] Bitboard attackers(const BoardState &state, const Square sq, const Side s) noexcept {
+    const auto occ = state.occupied();
+    const auto bishops = state.pieces(s, Piece::Bishop) | state.pieces(s, Piece::Queen);
+    const auto rooks = state.pieces(s, Piece::Rook) | state.pieces(s, Piece::Queen);
+    const auto pawns = s == Side::White ? pawn_attacks<Side::Black>(Bitboard{sq}) : pawn_attacks<Side::White>(Bitboard{sq});
+    return (pawns & state.pieces(s, Piece::Pawn)) | (movegen::knight_moves(sq) & state.pieces(s, Piece::Knight)) |
+           (movegen::bishop_moves(sq, occ) & bishops) | (movegen::rook_moves(sq, occ) & rooks) |
+           (movegen::king_moves(sq) & state.pieces(s, Piece::King));
+}
+
+}  // namespace
+
+[[nodiscard]] FenResult parse_fen(std::string_view fen) noexcept {
+    if (fen == "startpos") {
+        fen = startpos_fen;
+    }
+
+    FenResult result;
+    auto &state = result.state;
+    std::size_t pos = 0;
+
+    const auto fail = [&result](const FenError error, const std::size_t offset) {
+        result.error = error;
+        result.offset = offset;
+        return result;
+    };
+
+    // Fields are views into the string, so their offset comes from where they start
+    const auto offset_of = [&fen](const std::string_view field) {
+        return static_cast<std::size_t>(field.data() - fen.data());
+    };
+
+    // Piece placement, from a8 to h1
+    const auto board = next_field(fen, pos);
+    {
+        int rank = 7;
+        int file = 0;
+        bool last_digit = false;
+        for (std::size_t i = 0; i < board.size(); ++i) {
+            const auto c = board[i];
+            if (c == '/') {
+                if (file != 8 || rank == 0) {
+                    return fail(FenError::Board, offset_of(board) + i);
+                }
+                rank--;
+                file = 0;
+                last_digit = false;
+            } else if (c >= '1' && c <= '8') {
+                file += c - '0';
+                if (file > 8 || last_digit) {
+                    return fail(FenError::Board, offset_of(board) + i);
+                }
+                last_digit = true;
+            } else {
+                Side s;
+                Piece p;
+                if (!parse_piece(c, s, p) || file > 7) {
+                    return fail(FenError::Board, offset_of(board) + i);
+                }
+                const auto sq = Square(file, rank);
+                state.colour_bb[s] |= sq;
+                state.piece_bb[p] |= sq;
+                file++;
+                last_digit = false;
+            }
+        }
+        if (rank != 0 || file != 8) {
+            return fail(FenError::Board, offset_of(board) + board.size());
+        }
+    }
+
+    if (state.pieces(Side::White, Piece::King).count() != 1 || state.pieces(Side::Black, Piece::King).count() != 1) {
+        return fail(FenError::Kings, offset_of(board));
+    }
+
+    if (state.occupancy(Piece::Pawn) & (bitboards::Rank1 | bitboards::Rank8)) {
+        return fail(FenError::Pawns, offset_of(board));
+    }
+
+    // Side to move
+    {
+        const auto word = next_field(fen, pos);
+        if (word == "w") {
+            state.turn = Side::White;
+        } else if (word == "b") {
+            state.turn = Side::Black;
+        } else {
+            return fail(FenError::Turn, offset_of(word));
+        }
+    }
+
+    // Castling rights, each right needs its king and rook at home
+    {
+        const auto word = next_field(fen, pos);
+        if (word.empty() || word.size() > 4) {
+            return fail(FenError::Castling, offset_of(word));
+        }
+        if (word != "-") {
+            for (std::size_t i = 0; i < word.size(); ++i) {
+                const auto c = word[i];
+                std::uint8_t right = 0;
+                Side s = Side::White;
+                Square rook = squares::OffSq;
+                switch (c) {
+                    case 'K':
+                        right = Castling::WhiteKSC;
+                        rook = ksc_rook_fr[Side::White];
+                        break;
+                    case 'Q':
+                        right = Castling::WhiteQSC;
+                        rook = qsc_rook_fr[Side::White];
+                        break;
+                    case 'k':
+                        right = Castling::BlackKSC;
+                        s = Side::Black;
+                        rook = ksc_rook_fr[Side::Black];
+                        break;
+                    case 'q':
+                        right = Castling::BlackQSC;
+                        s = Side::Black;
+                        rook = qsc_rook_fr[Side::Black];
+                        break;
+                    default:
+                        return fail(FenError::Castling, offset_of(word) + i);
+                }
+                const auto king = s == Side::White ? squares::E1 : squares::E8;
+                if ((state.castling & right) || !(state.pieces(s, Piece::King) & king) ||
+                    !(state.pieces(s, Piece::Rook) & rook)) {
+                    return fail(FenError::Castling, offset_of(word) + i);
+                }
+                state.castling |= right;
+            }
+        }
+    }
+
+    // En passant, some sources set it after every double push and others only when a capture is possible
+    // A square that no double push could have left is dropped as Stockfish does, rather than rejected
+    {
+        const auto word = next_field(fen, pos);
+        if (word.empty()) {
+            return fail(FenError::EnPassant, offset_of(word));
+        }
+        if (word != "-") {
+            const auto rank = state.turn == Side::White ? '6' : '3';
+            if (word.size() != 2 || word[0] < 'a' || word[0] > 'h' || word[1] != rank) {
+                return fail(FenError::EnPassant, offset_of(word));
+            }
+            state.ep = Square(word[0] - 'a', word[1] - '1');
+            if (state.occupied() & state.ep) {
+                return fail(FenError::EnPassant, offset_of(word));
+            }
+            // Their pawn has to be in front of the square and the square it started on empty, otherwise
+            // making an en passant capture would remove a pawn that isn't there
+            const int forward = state.turn == Side::White ? 1 : -1;
+            const auto pushed = Square(state.ep.file(), state.ep.rank() - forward);
+            const auto start = Square(state.ep.file(), state.ep.rank() + forward);
+            if (!(state.pieces(!state.turn, Piece::Pawn) & pushed) || (state.occupied() & start)) {
+                state.ep = squares::OffSq;
+            }
+        }
+    }
+
+    // Move clocks
+    state.halfmove_clock = 0;
+    state.fullmove_clock = 1;
+    if (const auto word = next_field(fen, pos); !word.empty()) {
+        if (!parse_clock(word, state.halfmove_clock)) {
+            return fail(FenError::HalfmoveClock, offset_of(word));
+        }
+        const auto fullmove = next_field(fen, pos);
+        if (!parse_clock(fullmove, state.fullmove_clock) || state.fullmove_clock == 0) {
+            return fail(FenError::FullmoveClock, offset_of(fullmove));
+        }
+    }
+
+    if (const auto word = next_field(fen, pos); !word.empty()) {
+        return fail(FenError::Trailing, offset_of(word));
+    }
+
+    // Better not be able to capture the king
+    if (attackers(state, state.pieces(!state.turn, Piece::King).lsb(), state.turn)) {
+        return fail(FenError::Check, offset_of(board));
+    }
+
+#ifndef NO_HASH
+    state.hash = state.calculate_hash();
+    state.pawn_hash = state.calculate_pawn_hash();
+    state.material_key = state.calculate_material_key();
+#endif
+
+    return result;
+}
+
+}  // namespace libchess
@@ -0,0 +1,78 @@
+#include <stdexcept>
+#include <string_view>
+#include "libchess/position.hpp"
+
+namespace libchess {
+
+// Decodes the move straight from the string and the board, then checks it with is_legal()
+[[nodiscard]] Move Position::parse_move(const std::string_view str) const {
+    if (str.size() != 4 && str.size() != 5) {
+        throw std::invalid_argument("Illegal move string");
+    }
+
+    for (std::size_t i = 0; i < 4; i += 2) {
+        if (str[i] < 'a' || str[i] > 'h' || str[i + 1] < '1' || str[i + 1] > '8') {
+            throw std::invalid_argument("Illegal move string");
+        }
+    }
+
+    const auto from = Square(str[0] - 'a', str[1] - '1');
+    const auto to = Square(str[2] - 'a', str[3] - '1');
+    const auto piece = piece_on(from);
+    auto captured = piece_on(to);
+    auto promo = Piece::None;
+
+    if (str.size() == 5) {
+        switch (str[4]) {
+            case 'n':
+                promo = Piece::Knight;
+                break;
+            case 'b':
+                promo = Piece::Bishop;
+                break;
+            case 'r':
+                promo = Piece::Rook;
+                break;
+            case 'q':
+                promo = Piece::Queen;
+                break;
+            default:
+                throw std::invalid_argument("Illegal move string");
+        }
+    }
+
+    // Catch anything Move can't represent before building one
+    if (piece == Piece::None || from == to || captured == Piece::King) {
+        throw std::invalid_argument("Illegal move string");
+    }
+    if (promo != Piece::None && (piece != Piece::Pawn || captured == Piece::Pawn)) {
+        throw std::invalid_argument("Illegal move string");
+    }
+
+    auto type = captured == Piece::None ? MoveType::Normal : MoveType::Capture;
+    if (piece == Piece::Pawn) {
+        if (promo != Piece::None) {
+            type = captured == Piece::None ? MoveType::promo : MoveType::promo_capture;
+        } else if (to == state_.ep && from.file() != to.file()) {
+            type = MoveType::enpassant;
+            captured = Piece::Pawn;
+        } else if (captured == Piece::None && (from.rank() - to.rank() == 2 || to.rank() - from.rank() == 2)) {
+            type = MoveType::Double;
+        }
+    } else if (piece == Piece::King && captured == Piece::None && from.file() == 4 && from.rank() == to.rank()) {
+        if (to.file() == 6) {
+            type = MoveType::ksc;
+        } else if (to.file() == 2) {
+            type = MoveType::qsc;
+        }
+    }
+
+    const auto move = Move(type, from, to, piece, captured, promo);
+    if (!is_legal(move)) {
+        throw std::invalid_argument("Illegal move string");
+    }
+
+    return move;
+}
+
+}  // namespace libchess
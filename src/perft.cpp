@@ -11,7 +11,8 @@ namespace libchess {
 
     std::uint64_t nodes = 0;
 
-    const auto moves = legal_moves();
+    MoveList moves;
+    legal_moves(moves);
     for (const auto &move : moves) {
         makemove(move);
         nodes += perft(depth - 1);
@@ -5,7 +5,7 @@
 namespace libchess {
 
 [[nodiscard]] Bitboard Position::pinned() const noexcept {
-    return pinned(turn(), king_position(turn()));
+    return check_info().pinned_diagonal | check_info().pinned_orthogonal;
 }
 
 [[nodiscard]] Bitboard Position::pinned(const Side s) const noexcept {
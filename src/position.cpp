@@ -0,0 +1,20 @@
+#include <algorithm>
+#include "libchess/position.hpp"
+
+namespace libchess {
+
+// Out of line, copying and freeing the history and check stacks is too big to inline at every call site
+Position::Position(const Position &other) = default;
+
+Position &Position::operator=(const Position &other) = default;
+
+Position::~Position() noexcept = default;
+
+// At least doubles, so a game longer than history_capacity still only reallocates now and then
+void Position::reserve_history() noexcept {
+    const auto capacity = std::max(history_capacity, 2 * history_.size());
+    history_.reserve(capacity);
+    check_info_history_.reserve(capacity);
+}
+
+}  // namespace libchess
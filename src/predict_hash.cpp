@@ -17,8 +17,8 @@ namespace libchess {
     const auto promo = move.promotion();
 
     new_hash ^= zobrist::turn_key();
-    if (ep_ != squares::OffSq) {
-        new_hash ^= zobrist::ep_key(ep_);
+    if (state_.ep != squares::OffSq) {
+        new_hash ^= zobrist::ep_key(state_.ep);
     }
 
     switch (move.type()) {
@@ -70,21 +70,10 @@ namespace libchess {
             abort();
     }
 
-    if (can_castle(Side::White, MoveType::ksc) && (to == squares::H1 || from == squares::E1 || from == squares::H1)) {
-        new_hash ^= zobrist::castling_key(usKSC);
-    }
-
-    if (can_castle(Side::White, MoveType::qsc) && (to == squares::A1 || from == squares::E1 || from == squares::A1)) {
-        new_hash ^= zobrist::castling_key(usQSC);
-    }
-
-    if (can_castle(Side::Black, MoveType::ksc) && (to == squares::H8 || from == squares::E8 || from == squares::H8)) {
-        new_hash ^= zobrist::castling_key(themKSC);
-    }
-
-    if (can_castle(Side::Black, MoveType::qsc) && (to == squares::A8 || from == squares::E8 || from == squares::A8)) {
-        new_hash ^= zobrist::castling_key(themQSC);
-    }
+    // Castling permissions
+    const auto castling_lost =
+        state_.castling & ~(castling_kept[static_cast<int>(from)] & castling_kept[static_cast<int>(to)]);
+    new_hash ^= zobrist::castling_rights_key(castling_lost);
 
     return new_hash;
 #endif
@@ -0,0 +1,150 @@
+#include <cassert>
+#include "libchess/bitboard.hpp"
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+#include "libchess/square.hpp"
+
+namespace libchess {
+
+[[nodiscard]] std::vector<Move> Position::pseudo_legal_moves() const noexcept {
+    MoveList moves;
+    pseudo_legal_moves(moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Position::pseudo_legal_moves(MoveList &moves) const noexcept {
+    if (turn() == Side::White) {
+        pseudo_legal_moves<Side::White>(moves);
+    } else {
+        pseudo_legal_moves<Side::Black>(moves);
+    }
+}
+
+// Moves that follow the piece movement rules but may leave our king in check
+// Castling only checks the rights and the path, attacks are left to is_pseudo_legal_move_legal()
+template <Side Us>
+void Position::pseudo_legal_moves(MoveList &moves) const noexcept {
+    [[maybe_unused]] const auto start_size = moves.size();
+    constexpr auto them = !Us;
+    constexpr auto promo_rank = relative_rank<Us>(7);
+    constexpr auto double_rank = relative_rank<Us>(3);
+    const auto ksq = king_position(Us);
+    const auto occ = occupied();
+    const auto enemy = occupancy(them);
+
+    const auto add_piece_moves = [&](const Square fr, const Piece piece, const Bitboard mask) {
+        for (const auto &to : mask & enemy) {
+            const auto cap = piece_on(to);
+            assert(cap != Piece::None);
+            moves.emplace_back(MoveType::Capture, fr, to, piece, cap);
+        }
+        for (const auto &to : mask & ~occ) {
+            moves.emplace_back(MoveType::Normal, fr, to, piece);
+        }
+    };
+
+    // Pawns
+    {
+        const auto pawns = pieces(Us, Piece::Pawn);
+        const auto singles = forward<Us>(pawns) & ~occ;
+        const auto doubles = forward<Us>(singles) & ~occ & double_rank;
+        const auto right = forward<Us>(pawns).east() & enemy;
+        const auto left = forward<Us>(pawns).west() & enemy;
+
+        const auto add_promos = [&](const MoveType type, const Square fr, const Square to, const Piece cap) {
+            moves.emplace_back(type, fr, to, Piece::Pawn, cap, Piece::Queen);
+            moves.emplace_back(type, fr, to, Piece::Pawn, cap, Piece::Rook);
+            moves.emplace_back(type, fr, to, Piece::Pawn, cap, Piece::Bishop);
+            moves.emplace_back(type, fr, to, Piece::Pawn, cap, Piece::Knight);
+        };
+
+        // Captures
+        for (const auto &sq : right) {
+            const auto fr = backward<Us>(sq).west();
+            if (promo_rank & sq) {
+                add_promos(MoveType::promo_capture, fr, sq, piece_on(sq));
+            } else {
+                moves.emplace_back(MoveType::Capture, fr, sq, Piece::Pawn, piece_on(sq));
+            }
+        }
+        for (const auto &sq : left) {
+            const auto fr = backward<Us>(sq).east();
+            if (promo_rank & sq) {
+                add_promos(MoveType::promo_capture, fr, sq, piece_on(sq));
+            } else {
+                moves.emplace_back(MoveType::Capture, fr, sq, Piece::Pawn, piece_on(sq));
+            }
+        }
+
+        // En passant
+        if (state_.ep != squares::OffSq) {
+            for (const auto &fr : pawn_attacks<them>(Bitboard{state_.ep}) & pawns) {
+                moves.emplace_back(MoveType::enpassant, fr, state_.ep, Piece::Pawn, Piece::Pawn);
+            }
+        }
+
+        // Singles
+        for (const auto &sq : singles) {
+            const auto fr = backward<Us>(sq);
+            if (promo_rank & sq) {
+                add_promos(MoveType::promo, fr, sq, Piece::None);
+            } else {
+                moves.emplace_back(MoveType::Normal, fr, sq, Piece::Pawn);
+            }
+        }
+
+        // Doubles
+        for (const auto &sq : doubles) {
+            moves.emplace_back(MoveType::Double, backward<Us>(backward<Us>(sq)), sq, Piece::Pawn);
+        }
+    }
+
+    // Knights
+    for (const auto &fr : pieces(Us, Piece::Knight)) {
+        add_piece_moves(fr, Piece::Knight, movegen::knight_moves(fr));
+    }
+
+    // Bishops
+    for (const auto &fr : pieces(Us, Piece::Bishop)) {
+        add_piece_moves(fr, Piece::Bishop, movegen::bishop_moves(fr, occ));
+    }
+
+    // Rooks
+    for (const auto &fr : pieces(Us, Piece::Rook)) {
+        add_piece_moves(fr, Piece::Rook, movegen::rook_moves(fr, occ));
+    }
+
+    // Queens
+    for (const auto &fr : pieces(Us, Piece::Queen)) {
+        add_piece_moves(fr, Piece::Queen, movegen::queen_moves(fr, occ));
+    }
+
+    // King
+    add_piece_moves(ksq, Piece::King, movegen::king_moves(ksq));
+
+    // Castling
+    {
+        constexpr auto ksq_start = relative_square<Us>(squares::E1);
+        constexpr auto ksc_path = squares_between(ksq_start, ksc_rook_fr[Us]);
+        constexpr auto qsc_path = squares_between(ksq_start, qsc_rook_fr[Us]);
+
+        if (can_castle(Us, MoveType::ksc) && !(occ & ksc_path)) {
+            moves.emplace_back(MoveType::ksc, ksq_start, relative_square<Us>(squares::G1), Piece::King);
+        }
+        if (can_castle(Us, MoveType::qsc) && !(occ & qsc_path)) {
+            moves.emplace_back(MoveType::qsc, ksq_start, relative_square<Us>(squares::C1), Piece::King);
+        }
+    }
+
+#ifndef NDEBUG
+    for (std::size_t i = start_size; i < moves.size(); ++i) {
+        assert(moves[i].captured() != Piece::King);
+    }
+#endif
+}
+
+template void Position::pseudo_legal_moves<Side::White>(MoveList &moves) const noexcept;
+template void Position::pseudo_legal_moves<Side::Black>(MoveList &moves) const noexcept;
+
+}  // namespace libchess
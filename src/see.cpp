@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cassert>
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+// Static exchange evaluation of the square the move lands on, in centipawns from our point of view
+// Captures are made least valuable attacker first, either side may stop once continuing would lose material
+// Pins are ignored
+[[nodiscard]] int Position::see(const Move &move) const noexcept {
+    if (move.type() == MoveType::ksc || move.type() == MoveType::qsc) {
+        return 0;
+    }
+
+    const auto from = move.from();
+    const auto to = move.to();
+    const auto bishops = occupancy(Piece::Bishop) | occupancy(Piece::Queen);
+    const auto rooks = occupancy(Piece::Rook) | occupancy(Piece::Queen);
+    auto occ = occupied() ^ from;
+    auto side = !turn();
+    int gain[32] = {};
+    int depth = 0;
+
+    gain[0] = piece_values[move.captured()];
+
+    // The piece standing on the square, and so the next one to be captured
+    auto victim = move.piece();
+    if (move.is_promoting()) {
+        victim = move.promotion();
+        gain[0] += piece_values[move.promotion()] - piece_values[Piece::Pawn];
+    }
+
+    if (move.type() == MoveType::enpassant) {
+        occ ^= turn() == Side::White ? backward<Side::White>(to) : backward<Side::Black>(to);
+    }
+
+    auto attackers = attackers_to(to, occ) & occ;
+
+    while (true) {
+        const auto ours = attackers & occupancy(side);
+        if (!ours) {
+            break;
+        }
+
+        // Least valuable attacker
+        auto piece = Piece::Pawn;
+        while (!(ours & occupancy(piece))) {
+            piece = static_cast<Piece>(piece + 1);
+        }
+        assert(piece <= Piece::King);
+
+        depth++;
+        assert(depth < 32);
+        gain[depth] = piece_values[victim] - gain[depth - 1];
+
+        occ ^= (ours & occupancy(piece)).lsb();
+
+        // Uncover any sliders behind the piece that just captured
+        if (piece == Piece::Pawn || piece == Piece::Bishop || piece == Piece::Queen) {
+            attackers |= movegen::bishop_moves(to, occ) & bishops;
+        }
+        if (piece == Piece::Rook || piece == Piece::Queen) {
+            attackers |= movegen::rook_moves(to, occ) & rooks;
+        }
+        attackers &= occ;
+
+        victim = piece;
+        side = !side;
+    }
+
+    // Each side picks between capturing and stopping, working back from the end of the sequence
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+
+    return gain[0];
+}
+
+}  // namespace libchess
@@ -0,0 +1,90 @@
+#include <cassert>
+#include "libchess/movegen.hpp"
+#include "libchess/position.hpp"
+#include "libchess/relative.hpp"
+
+namespace libchess {
+
+// Equivalent to see(move) >= threshold, but stops as soon as the answer is known
+[[nodiscard]] bool Position::see_ge(const Move &move, const int threshold) const noexcept {
+    if (move.type() == MoveType::ksc || move.type() == MoveType::qsc) {
+        return 0 >= threshold;
+    }
+
+    const auto from = move.from();
+    const auto to = move.to();
+    const auto bishops = occupancy(Piece::Bishop) | occupancy(Piece::Queen);
+    const auto rooks = occupancy(Piece::Rook) | occupancy(Piece::Queen);
+    auto occ = occupied() ^ from;
+    auto victim = move.piece();
+    int gain = piece_values[move.captured()];
+
+    if (move.is_promoting()) {
+        victim = move.promotion();
+        gain += piece_values[move.promotion()] - piece_values[Piece::Pawn];
+    }
+
+    if (move.type() == MoveType::enpassant) {
+        occ ^= turn() == Side::White ? backward<Side::White>(to) : backward<Side::Black>(to);
+    }
+
+    // Even if nothing recaptures we don't make the threshold
+    auto swap = gain - threshold;
+    if (swap < 0) {
+        return false;
+    }
+
+    // Even if we lose the piece we still make the threshold
+    swap = piece_values[victim] - swap;
+    if (swap <= 0) {
+        return true;
+    }
+
+    auto attackers = attackers_to(to, occ) & occ;
+    auto side = turn();
+    bool result = true;
+
+    while (true) {
+        side = !side;
+        attackers &= occ;
+
+        const auto ours = attackers & occupancy(side);
+        if (!ours) {
+            break;
+        }
+
+        // Least valuable attacker
+        auto piece = Piece::Pawn;
+        while (!(ours & occupancy(piece))) {
+            piece = static_cast<Piece>(piece + 1);
+        }
+        assert(piece <= Piece::King);
+
+        // The king can only capture if nothing recaptures
+        if (piece == Piece::King) {
+            return (attackers & occupancy(!side)) ? result : !result;
+        }
+
+        result = !result;
+
+        // The side to capture stops once they're ahead no matter what follows
+        swap = piece_values[piece] - swap;
+        if (swap < static_cast<int>(result)) {
+            break;
+        }
+
+        occ ^= (ours & occupancy(piece)).lsb();
+
+        // Uncover any sliders behind the piece that just captured
+        if (piece == Piece::Pawn || piece == Piece::Bishop || piece == Piece::Queen) {
+            attackers |= movegen::bishop_moves(to, occ) & bishops;
+        }
+        if (piece == Piece::Rook || piece == Piece::Queen) {
+            attackers |= movegen::rook_moves(to, occ) & rooks;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace libchess
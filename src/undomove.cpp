@@ -1,44 +1,59 @@
 #include "libchess/position.hpp"
+#include "libchess/relative.hpp"
 
 namespace libchess {
 
 void Position::undomove() noexcept {
+    if (turn() == Side::White) {
+        undomove<Side::Black>();
+    } else {
+        undomove<Side::White>();
+    }
+}
+
+template <Side Us>
+void Position::undomove() noexcept {
+    constexpr auto them = !Us;
+
     // Swap sides
-    to_move_ = !to_move_;
+    state_.turn = Us;
 
     const auto &move = history_.back().move;
-    const auto us = turn();
-    const auto them = !turn();
     const auto piece = move.piece();
     const auto captured = move.captured();
     const auto promo = move.promotion();
 
     // En passant
-    ep_ = history_.back().ep;
+    state_.ep = history_.back().ep;
 
     // Halfmoves
-    halfmove_clock_ = history_.back().halfmove_clock;
+    state_.halfmove_clock = history_.back().halfmove_clock;
 
     // Fullmoves
-    fullmove_clock_ -= us == Side::Black;
+    if constexpr (Us == Side::Black) {
+        state_.fullmove_clock--;
+    }
 
     // Castling
-    castling_[0] = history_.back().castling[0];
-    castling_[1] = history_.back().castling[1];
-    castling_[2] = history_.back().castling[2];
-    castling_[3] = history_.back().castling[3];
+    state_.castling = history_.back().castling;
 
 #ifndef NO_HASH
-    hash_ = history_.back().hash;
+    state_.hash = history_.back().hash;
+    state_.pawn_hash = history_.back().pawn_hash;
+    state_.material_key = history_.back().material_key;
 #endif
 
     // Remove piece
-    colours_[us] ^= move.to();
-    pieces_[piece] ^= move.to();
+    state_.colour_bb[Us] ^= move.to();
+    state_.piece_bb[piece] ^= move.to();
 
     // Add piece
-    colours_[us] ^= move.from();
-    pieces_[piece] ^= move.from();
+    state_.colour_bb[Us] ^= move.from();
+    state_.piece_bb[piece] ^= move.from();
+
+    // Anything captured on the destination square is put back below
+    board_[static_cast<int>(move.from())] = piece;
+    board_[static_cast<int>(move.to())] = Piece::None;
 
     switch (move.type()) {
         case MoveType::Normal:
@@ -46,47 +61,49 @@ void Position::undomove() noexcept {
         case MoveType::Double:
             break;
         case MoveType::Capture:
-            colours_[them] ^= move.to();
-            pieces_[captured] ^= move.to();
+            state_.colour_bb[them] ^= move.to();
+            state_.piece_bb[captured] ^= move.to();
+            board_[static_cast<int>(move.to())] = captured;
             break;
         case MoveType::enpassant:
             // Replace the captured pawn
-            if (turn() == Side::White) {
-                pieces_[Piece::Pawn] ^= move.to().south();
-                colours_[Side::Black] ^= move.to().south();
-            } else {
-                pieces_[Piece::Pawn] ^= move.to().north();
-                colours_[Side::White] ^= move.to().north();
-            }
+            state_.piece_bb[Piece::Pawn] ^= backward<Us>(move.to());
+            state_.colour_bb[them] ^= backward<Us>(move.to());
+            board_[static_cast<int>(backward<Us>(move.to()))] = Piece::Pawn;
             break;
         case MoveType::ksc:
             // Remove the rook
-            colours_[us] ^= ksc_rook_fr[us];
-            pieces_[Piece::Rook] ^= ksc_rook_fr[us];
+            state_.colour_bb[Us] ^= ksc_rook_fr[Us];
+            state_.piece_bb[Piece::Rook] ^= ksc_rook_fr[Us];
             // Add the rook
-            colours_[us] ^= ksc_rook_to[us];
-            pieces_[Piece::Rook] ^= ksc_rook_to[us];
+            state_.colour_bb[Us] ^= ksc_rook_to[Us];
+            state_.piece_bb[Piece::Rook] ^= ksc_rook_to[Us];
+            board_[static_cast<int>(ksc_rook_fr[Us])] = Piece::Rook;
+            board_[static_cast<int>(ksc_rook_to[Us])] = Piece::None;
             break;
         case MoveType::qsc:
             // Remove the rook
-            colours_[us] ^= qsc_rook_fr[us];
-            pieces_[Piece::Rook] ^= qsc_rook_fr[us];
+            state_.colour_bb[Us] ^= qsc_rook_fr[Us];
+            state_.piece_bb[Piece::Rook] ^= qsc_rook_fr[Us];
             // Add the rook
-            colours_[us] ^= qsc_rook_to[us];
-            pieces_[Piece::Rook] ^= qsc_rook_to[us];
+            state_.colour_bb[Us] ^= qsc_rook_to[Us];
+            state_.piece_bb[Piece::Rook] ^= qsc_rook_to[Us];
+            board_[static_cast<int>(qsc_rook_fr[Us])] = Piece::Rook;
+            board_[static_cast<int>(qsc_rook_to[Us])] = Piece::None;
             break;
         case MoveType::promo:
             // Replace piece with pawn
-            pieces_[Piece::Pawn] ^= move.to();
-            pieces_[promo] ^= move.to();
+            state_.piece_bb[Piece::Pawn] ^= move.to();
+            state_.piece_bb[promo] ^= move.to();
             break;
         case MoveType::promo_capture:
             // Replace pawn with piece
-            pieces_[Piece::Pawn] ^= move.to();
-            pieces_[promo] ^= move.to();
+            state_.piece_bb[Piece::Pawn] ^= move.to();
+            state_.piece_bb[promo] ^= move.to();
             // Replace the captured piece
-            pieces_[captured] ^= move.to();
-            colours_[them] ^= move.to();
+            state_.piece_bb[captured] ^= move.to();
+            state_.colour_bb[them] ^= move.to();
+            board_[static_cast<int>(move.to())] = captured;
             break;
         default:
             break;
@@ -94,8 +111,13 @@ void Position::undomove() noexcept {
 
     // Remove from history
     history_.pop_back();
+    check_info_ = check_info_history_.back();
+    check_info_history_.pop_back();
 
     assert(valid());
 }
 
+template void Position::undomove<Side::White>() noexcept;
+template void Position::undomove<Side::Black>() noexcept;
+
 }  // namespace libchess
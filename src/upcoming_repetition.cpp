@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include "libchess/position.hpp"
+#include "libchess/zobrist.hpp"
+
+namespace libchess {
+
+namespace {
+
+struct Cuckoo {
+    std::array<std::uint64_t, 8192> keys = {};
+    std::array<Move, 8192> moves = {};
+    int count = 0;
+};
+
+[[nodiscard]] constexpr int cuckoo_h1(const std::uint64_t key) noexcept {
+    return key & 0x1fff;
+}
+
+[[nodiscard]] constexpr int cuckoo_h2(const std::uint64_t key) noexcept {
+    return (key >> 16) & 0x1fff;
+}
+
+// Can the piece move between the squares on an empty board
+[[nodiscard]] constexpr bool reaches(const Piece p, const Square a, const Square b) noexcept {
+    const auto df = a.file() > b.file() ? a.file() - b.file() : b.file() - a.file();
+    const auto dr = a.rank() > b.rank() ? a.rank() - b.rank() : b.rank() - a.rank();
+    switch (p) {
+        case Piece::Knight:
+            return (df == 1 && dr == 2) || (df == 2 && dr == 1);
+        case Piece::Bishop:
+            return df == dr;
+        case Piece::Rook:
+            return df == 0 || dr == 0;
+        case Piece::Queen:
+            return df == dr || df == 0 || dr == 0;
+        case Piece::King:
+            return df <= 1 && dr <= 1;
+        case Piece::Pawn:
+        case Piece::None:
+        default:
+            return false;
+    }
+}
+
+// Every reversible move keyed by the hash difference it makes, so a hash difference can be looked up
+// in one of two slots. Pawn moves are irreversible and never part of a cycle.
+constexpr auto cuckoo = [] {
+    Cuckoo table;
+    for (const auto s : {Side::White, Side::Black}) {
+        for (const auto p : {Piece::Knight, Piece::Bishop, Piece::Rook, Piece::Queen, Piece::King}) {
+            for (int a = 0; a < 64; ++a) {
+                for (int b = a + 1; b < 64; ++b) {
+                    if (!reaches(p, Square(a), Square(b))) {
+                        continue;
+                    }
+
+                    auto move = Move(MoveType::Normal, Square(a), Square(b), p);
+                    auto key = zobrist::piece_key(p, s, Square(a)) ^ zobrist::piece_key(p, s, Square(b)) ^
+                               zobrist::turn_key();
+
+                    // Displace whatever is in the way into its other slot until an empty one turns up
+                    auto i = cuckoo_h1(key);
+                    while (true) {
+                        std::swap(table.keys[i], key);
+                        std::swap(table.moves[i], move);
+                        if (key == 0) {
+                            break;
+                        }
+                        i = i == cuckoo_h1(key) ? cuckoo_h2(key) : cuckoo_h1(key);
+                    }
+
+                    table.count++;
+                }
+            }
+        }
+    }
+    return table;
+}();
+
+static_assert(cuckoo.count == 3668);
+
+}  // namespace
+
+// Can the side to move reach an earlier position with a single reversible move
+// Before the root, ply plies ago, the earlier position has to have repeated already
+[[nodiscard]] bool Position::upcoming_repetition(const int ply) const noexcept {
+#ifdef NO_HASH
+    return false;
+#else
+    assert(ply >= 0);
+
+    const auto end = std::min<std::size_t>(halfmoves(), history_.size());
+    if (end < 3) {
+        return false;
+    }
+
+    const auto occ = occupied();
+    for (std::size_t i = 3; i <= end; i += 2) {
+        const auto earlier = history_[history_.size() - i].hash;
+        const auto diff = state_.hash ^ earlier;
+
+        auto j = cuckoo_h1(diff);
+        if (cuckoo.keys[j] != diff) {
+            j = cuckoo_h2(diff);
+            if (cuckoo.keys[j] != diff) {
+                continue;
+            }
+        }
+
+        const auto a = cuckoo.moves[j].from();
+        const auto b = cuckoo.moves[j].to();
+
+        // The other end is empty since only the one piece differs, so just the path has to be clear
+        if (squares_between(a, b) & occ) {
+            continue;
+        }
+
+        if (static_cast<std::size_t>(ply) > i) {
+            return true;
+        }
+
+        // At or before the root the move has to be ours and the earlier position a repetition itself
+        if (colour_on(occ & a ? a : b) != turn()) {
+            continue;
+        }
+
+        for (std::size_t k = i + 4; k <= end; k += 2) {
+            if (history_[history_.size() - k].hash == earlier) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+#endif
+}
+
+}  // namespace libchess
@@ -4,11 +4,19 @@ namespace libchess {
 
 [[nodiscard]] bool Position::valid() const noexcept {
 #ifdef NO_HASH
-    if (hash_ != 0) {
+    if (state_.hash != 0 || state_.pawn_hash != 0 || state_.material_key != 0) {
         return false;
     }
 #else
-    if (hash_ != calculate_hash()) {
+    if (state_.hash != calculate_hash()) {
+        return false;
+    }
+
+    if (state_.pawn_hash != calculate_pawn_hash()) {
+        return false;
+    }
+
+    if (state_.material_key != calculate_material_key()) {
         return false;
     }
 #endif
@@ -30,7 +38,7 @@ namespace libchess {
         return false;
     }
 
-    if (colours_[0] & colours_[1]) {
+    if (state_.colour_bb[0] & state_.colour_bb[1]) {
         return false;
     }
 
@@ -40,16 +48,25 @@ namespace libchess {
 
     for (int i = 0; i < 5; ++i) {
         for (int j = i + 1; j < 6; ++j) {
-            if (pieces_[i] & pieces_[j]) {
+            if (state_.piece_bb[i] & state_.piece_bb[j]) {
                 return false;
             }
         }
     }
 
-    if ((colours_[0] | colours_[1]) != (pieces_[0] | pieces_[1] | pieces_[2] | pieces_[3] | pieces_[4] | pieces_[5])) {
+    if ((state_.colour_bb[0] | state_.colour_bb[1]) != (state_.piece_bb[0] | state_.piece_bb[1] | state_.piece_bb[2] | state_.piece_bb[3] | state_.piece_bb[4] | state_.piece_bb[5])) {
         return false;
     }
 
+    // The mailbox has to agree with the bitboards
+    for (int i = 0; i < 64; ++i) {
+        const auto sq = Square(i);
+        const auto piece = board_[i];
+        if (piece == Piece::None ? static_cast<bool>(occupied() & sq) : !(state_.piece_bb[piece] & sq)) {
+            return false;
+        }
+    }
+
     // Better not be able to capture the king
     if (square_attacked(king_position(!turn()), turn())) {
         return false;
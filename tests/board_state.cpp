@@ -0,0 +1,61 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+namespace {
+
+void check(const libchess::BoardState &a, const libchess::BoardState &b) {
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(a.colour_bb[i] == b.colour_bb[i]);
+    }
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE(a.piece_bb[i] == b.piece_bb[i]);
+    }
+    REQUIRE(a.hash == b.hash);
+    REQUIRE(a.pawn_hash == b.pawn_hash);
+    REQUIRE(a.material_key == b.material_key);
+    REQUIRE(a.halfmove_clock == b.halfmove_clock);
+    REQUIRE(a.fullmove_clock == b.fullmove_clock);
+    REQUIRE(a.ep == b.ep);
+    REQUIRE(a.castling == b.castling);
+    REQUIRE(a.turn == b.turn);
+}
+
+void walk(libchess::Position &pos, const int depth) {
+    if (depth == 0) {
+        return;
+    }
+
+    const auto state = pos.state();
+    for (const auto &move : pos.legal_moves()) {
+        INFO(pos.get_fen());
+        INFO(static_cast<std::string>(move));
+        const auto next = state.after(move);
+        pos.makemove(move);
+        check(next, pos.state());
+        REQUIRE(libchess::Position(next).get_fen() == pos.get_fen());
+        walk(pos, depth - 1);
+        pos.undomove();
+    }
+
+    // after() must leave the original untouched
+    check(state, pos.state());
+}
+
+}  // namespace
+
+TEST_CASE("BoardState::after()") {
+    const std::array<std::string, 5> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        walk(pos, 3);
+    }
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+// Compare the evasion generator against the generic generators at every in check node
+void walk(libchess::Position &pos, const int depth, int &checks) {
+    if (depth == 0) {
+        return;
+    }
+
+    if (pos.in_check()) {
+        const auto evasions = pos.check_evasions();
+        auto expected = pos.legal_captures();
+        const auto noncaptures = pos.legal_noncaptures();
+        expected.insert(expected.end(), noncaptures.begin(), noncaptures.end());
+
+        INFO(pos.get_fen());
+        REQUIRE(evasions.size() == expected.size());
+        REQUIRE(std::is_permutation(evasions.begin(), evasions.end(), expected.begin()));
+        checks++;
+    } else {
+        // Only the king moves when not in check
+        const auto not_king_step = [](const libchess::Move &move) {
+            return move.piece() != libchess::Piece::King || move.type() == libchess::MoveType::ksc ||
+                   move.type() == libchess::MoveType::qsc;
+        };
+        auto expected = pos.legal_moves();
+        expected.erase(std::remove_if(expected.begin(), expected.end(), not_king_step), expected.end());
+        const auto evasions = pos.check_evasions();
+
+        INFO(pos.get_fen());
+        REQUIRE(evasions.size() == expected.size());
+        REQUIRE(std::is_permutation(evasions.begin(), evasions.end(), expected.begin()));
+    }
+
+    for (const auto &move : pos.legal_moves()) {
+        pos.makemove(move);
+        walk(pos, depth - 1, checks);
+        pos.undomove();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::check_evasions()") {
+    const std::array<std::pair<std::string, int>, 9> tests = {{
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3},
+        // Capture the checking pawn en passant
+        {"8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1", 1},
+        // Block a bishop check en passant, not reachable in a real game but still a valid FEN
+        {"8/8/k7/8/3Pp3/8/8/4KB2 b - d3 0 1", 1},
+        // En passant that would expose the king
+        {"8/8/8/4k3/3Pp3/8/8/K3R3 b - d3 0 1", 1},
+        // Double check
+        {"4k3/8/5N2/8/8/8/8/4RK2 b - - 0 1", 1},
+        // Promotion blocks and captures
+        {"1r2k3/P7/8/8/8/8/8/1K6 w - - 0 1", 1},
+    }};
+
+    for (const auto &[fen, depth] : tests) {
+        libchess::Position pos{fen};
+        int checks = 0;
+        walk(pos, depth, checks);
+        INFO(fen);
+        REQUIRE(checks > 0);
+    }
+
+    SECTION("Move counts") {
+        libchess::Position pos{"8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1"};
+        REQUIRE(pos.check_evasions().size() == 9);
+    }
+}
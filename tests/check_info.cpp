@@ -0,0 +1,106 @@
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+TEST_CASE("Position::check_info() -- Pins") {
+    using namespace libchess;
+
+    {
+        const Position pos{"4k3/8/4r3/8/4N3/8/8/4K3 w - - 0 1"};
+        const auto &ci = pos.check_info();
+        REQUIRE(ci.checkers == Bitboard{});
+        REQUIRE(ci.check_mask == bitboards::AllSquares);
+        REQUIRE(ci.pinned_diagonal == Bitboard{});
+        REQUIRE(ci.pinned_orthogonal == Bitboard(0x10000000));
+        REQUIRE(ci.pin_diagonal == Bitboard{});
+        REQUIRE(ci.pin_orthogonal == Bitboard(0x101010101000));
+    }
+
+    {
+        const Position pos{"4k3/8/8/7b/8/5B2/8/3K4 w - - 0 1"};
+        const auto &ci = pos.check_info();
+        REQUIRE(ci.checkers == Bitboard{});
+        REQUIRE(ci.pinned_diagonal == Bitboard(0x200000));
+        REQUIRE(ci.pinned_orthogonal == Bitboard{});
+        REQUIRE(ci.pin_diagonal == Bitboard(0x8040201000));
+        REQUIRE(ci.pin_orthogonal == Bitboard{});
+    }
+
+    {
+        // Two pieces between the king and the slider isn't a pin
+        const Position pos{"4k3/8/4r3/4n3/4N3/8/8/4K3 w - - 0 1"};
+        REQUIRE(pos.check_info().pinned_orthogonal == Bitboard{});
+    }
+}
+
+TEST_CASE("Position::check_info() -- Checks") {
+    using namespace libchess;
+
+    {
+        const Position pos{"4k3/8/8/8/8/8/8/r3K3 w - - 0 1"};
+        const auto &ci = pos.check_info();
+        REQUIRE(ci.checkers == Bitboard{squares::A1});
+        REQUIRE(ci.check_mask == Bitboard(0xf));
+        // The king can't step away along the checking ray
+        REQUIRE(ci.king_danger & squares::F1);
+    }
+
+    {
+        const Position pos{"4k3/8/8/8/8/3n4/8/r3K3 w - - 0 1"};
+        const auto &ci = pos.check_info();
+        REQUIRE(ci.checkers.count() == 2);
+        REQUIRE(ci.check_mask == Bitboard{});
+    }
+}
+
+TEST_CASE("Position::check_info() -- Cache") {
+    auto pos = libchess::Position{"4k3/8/8/8/8/8/8/r3K3 w - - 0 1"};
+    REQUIRE(pos.in_check());
+
+    pos.makemove("e1e2");
+    REQUIRE(!pos.in_check());
+    REQUIRE(pos.check_info().checkers.empty());
+
+    pos.undomove();
+    REQUIRE(pos.in_check());
+
+    pos.makemove("e1f2");
+    pos.makenull();
+    REQUIRE(!pos.in_check());
+    pos.undonull();
+    REQUIRE(!pos.in_check());
+
+    pos.set_fen("4k3/8/8/8/8/8/8/r3K3 w - - 0 1");
+    REQUIRE(pos.in_check());
+}
+
+TEST_CASE("Position::check_info() -- Make and undo") {
+    const auto same = [](const libchess::CheckInfo &a, const libchess::CheckInfo &b) {
+        return a.checkers == b.checkers && a.check_mask == b.check_mask && a.pinned_diagonal == b.pinned_diagonal &&
+               a.pinned_orthogonal == b.pinned_orthogonal && a.pin_diagonal == b.pin_diagonal &&
+               a.pin_orthogonal == b.pin_orthogonal && a.king_danger == b.king_danger;
+    };
+
+    auto pos = libchess::Position{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"};
+    const auto before = pos.check_info();
+
+    for (const auto &move : pos.legal_moves()) {
+        pos.makemove(move);
+        REQUIRE(same(pos.check_info(), libchess::Position(pos.state()).check_info()));
+        for (const auto &reply : pos.legal_moves()) {
+            pos.makemove(reply);
+            REQUIRE(same(pos.check_info(), libchess::Position(pos.state()).check_info()));
+            pos.undomove();
+        }
+        if (!pos.in_check()) {
+            pos.makenull();
+            REQUIRE(same(pos.check_info(), libchess::Position(pos.state()).check_info()));
+            pos.undonull();
+        }
+        pos.undomove();
+        REQUIRE(same(pos.check_info(), before));
+    }
+
+    const auto copy = pos;
+    REQUIRE(same(copy.check_info(), before));
+}
@@ -0,0 +1,40 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+void count_moves(libchess::Position &pos, const int depth) noexcept {
+    REQUIRE(pos.count_moves() == pos.legal_moves().size());
+
+    if (depth == 0) {
+        return;
+    }
+
+    const auto moves = pos.legal_moves();
+    for (const auto &move : moves) {
+        pos.makemove(move);
+        count_moves(pos, depth - 1);
+        pos.undomove();
+    }
+}
+
+TEST_CASE("Position::count_moves()") {
+    const std::array<std::string, 10> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+        "8/8/8/8/1k1PpN1R/8/8/4K3 b - d3 0 1",
+        "4k3/8/K6r/3pP3/8/8/8/8 w - d6 0 1",
+        "4k3/2b3q1/3P1P2/4K3/3P1P2/2b3q1/8/8 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        libchess::Position pos{fen};
+        count_moves(pos, 2);
+    }
+}
@@ -151,3 +151,75 @@ TEST_CASE("Position::is_draw() threefold") {
         REQUIRE(pos.is_terminal() == ans);
     }
 }
+
+TEST_CASE("Position::is_repetition()") {
+    auto pos = libchess::Position("startpos");
+    for (const auto &movestr : {"g1f3", "g8f6", "f3g1", "f6g8"}) {
+        REQUIRE(!pos.is_repetition(0));
+        pos.makemove(movestr);
+    }
+
+    // Repeated once, only counts if that happened after the root
+    REQUIRE(!pos.is_repetition(0));
+    REQUIRE(!pos.is_repetition(4));
+    REQUIRE(pos.is_repetition(5));
+
+    for (const auto &movestr : {"g1f3", "g8f6", "f3g1", "f6g8"}) {
+        pos.makemove(movestr);
+    }
+
+    // Repeated twice
+    REQUIRE(pos.is_repetition(0));
+
+    // The scan stops at the last irreversible move
+    pos.set_fen("startpos");
+    for (const auto &movestr : {"g1f3", "g8f6", "f3g1", "f6g8", "e2e3", "e7e6"}) {
+        pos.makemove(movestr);
+    }
+    REQUIRE(!pos.is_repetition(100));
+}
+
+TEST_CASE("Position::upcoming_repetition()") {
+    SECTION("Knights") {
+        auto pos = libchess::Position("startpos");
+        for (const auto &movestr : {"g1f3", "g8f6"}) {
+            REQUIRE(!pos.upcoming_repetition(100));
+            pos.makemove(movestr);
+        }
+        REQUIRE(!pos.upcoming_repetition(100));
+
+        // f6g8 gets back to the start
+        pos.makemove("f3g1");
+        REQUIRE(pos.upcoming_repetition(4));
+        REQUIRE(!pos.upcoming_repetition(0));
+
+        for (const auto &movestr : {"f6g8", "g1f3", "g8f6", "f3g1"}) {
+            pos.makemove(movestr);
+        }
+
+        // The start has already repeated once
+        REQUIRE(pos.upcoming_repetition(0));
+    }
+
+    SECTION("Blocked path") {
+        const std::vector<std::string> moves = {"h1g1", "d8e7", "g1g2", "e7d6", "g2h1"};
+
+        // The queen would need d8d6 to get back
+        auto open = libchess::Position("3q3k/p7/8/8/8/8/8/7K w - - 0 1");
+        auto blocked = libchess::Position("3q3k/3p4/8/8/8/8/8/7K w - - 0 1");
+        for (const auto &movestr : moves) {
+            open.makemove(movestr);
+            blocked.makemove(movestr);
+        }
+        REQUIRE(open.upcoming_repetition(100));
+        REQUIRE(!blocked.upcoming_repetition(100));
+    }
+
+    SECTION("Irreversible") {
+        auto pos = libchess::Position("startpos");
+        for (const auto &movestr : {"g1f3", "g8f6", "f3g1", "e7e6"}) {
+            pos.makemove(movestr);
+        }
+        REQUIRE(!pos.upcoming_repetition(100));
+    }
+}
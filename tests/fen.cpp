@@ -1,6 +1,10 @@
 #include <array>
+#include <libchess/fen.hpp>
 #include <libchess/position.hpp>
+#include <libchess/validate.hpp>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include "catch.hpp"
 
@@ -56,3 +60,138 @@ TEST_CASE("Counters") {
         REQUIRE(pos.fullmoves() == full);
     }
 }
+
+TEST_CASE("parse_fen()") {
+    using pair_type = std::pair<std::string, libchess::FenError>;
+
+    const std::array<pair_type, 34> tests = {{
+        {"startpos", libchess::FenError::None},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::None},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -", libchess::FenError::None},
+        {"  rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR   w  KQkq  -  0  1  ", libchess::FenError::None},
+        {"rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3", libchess::FenError::None},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 65535 65535", libchess::FenError::None},
+        // Board
+        {"", libchess::FenError::Board},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbnr/pppppppp/44/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbnrr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbn/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::Board},
+        {"rnbqkbnx/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", libchess::FenError::Board},
+        // Kings and pawns
+        {"8/8/8/8/8/8/8/4K3 w - - 0 1", libchess::FenError::Kings},
+        {"4k3/8/8/8/8/8/8/3KK3 w - - 0 1", libchess::FenError::Kings},
+        {"P3k3/8/8/8/8/8/8/4K3 w - - 0 1", libchess::FenError::Pawns},
+        // Side to move
+        {"4k3/8/8/8/8/8/8/4K3 x - - 0 1", libchess::FenError::Turn},
+        {"4k3/8/8/8/8/8/8/4K3", libchess::FenError::Turn},
+        // Castling
+        {"4k3/8/8/8/8/8/8/4K3 w K - 0 1", libchess::FenError::Castling},
+        {"r3k2r/8/8/8/8/8/8/R3K2R w KK - 0 1", libchess::FenError::Castling},
+        {"r3k2r/8/8/8/8/8/8/R3K2R w KQkqK - 0 1", libchess::FenError::Castling},
+        {"r3k2r/8/8/8/8/8/8/R3K2R w X - 0 1", libchess::FenError::Castling},
+        {"r3k2r/8/8/8/8/8/8/r3K2R w Q - 0 1", libchess::FenError::Castling},
+        // En passant
+        {"4k3/8/8/8/3pP3/8/8/4K3 b - e4 0 1", libchess::FenError::EnPassant},
+        {"4k3/8/8/8/3pP3/8/8/4K3 b - e6 0 1", libchess::FenError::EnPassant},
+        {"4k3/8/8/8/3pP3/8/8/4K3 b - z3 0 1", libchess::FenError::EnPassant},
+        {"4k3/8/8/8/3pP3/8/8/4K3 b -", libchess::FenError::EnPassant},
+        // Clocks
+        {"4k3/8/8/8/8/8/8/4K3 w - - x 1", libchess::FenError::HalfmoveClock},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 65536 1", libchess::FenError::HalfmoveClock},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 0", libchess::FenError::FullmoveClock},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 0 0", libchess::FenError::FullmoveClock},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 0 1 extra", libchess::FenError::Trailing},
+        // The side that just moved can't be in check
+        {"4k3/8/8/8/8/8/8/4K2R w - - 0 1", libchess::FenError::None},
+    }};
+
+    for (const auto &[fen, error] : tests) {
+        INFO(fen);
+        REQUIRE(libchess::parse_fen(fen).error == error);
+        REQUIRE(libchess::validate::fen(fen) == (error == libchess::FenError::None));
+    }
+
+    REQUIRE(libchess::parse_fen("4k2R/8/8/8/8/8/8/4K3 w - - 0 1").error == libchess::FenError::Check);
+}
+
+TEST_CASE("parse_fen() -- En passant square without a pawn") {
+    // Kept, their pawn is in front of it
+    REQUIRE(libchess::parse_fen("8/6bb/8/8/R1pP2k1/4P3/P7/K7 b - d3 0 1").state.ep == libchess::Square("d3"));
+    REQUIRE(libchess::parse_fen("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 0 1").state.ep == libchess::Square("e6"));
+
+    // Dropped, the pawn in front is ours or missing, or the square it came from is taken
+    const std::array<std::string, 3> fens = {{
+        "8/6bb/8/8/R1pP2k1/4P3/P7/K7 b - c3 0 1",
+        "4k3/8/8/3P4/8/8/8/4K3 w - e6 0 1",
+        "4k3/4r3/8/3Pp3/8/8/8/4K3 w - e6 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        const auto result = libchess::parse_fen(fen);
+        REQUIRE(result.error == libchess::FenError::None);
+        REQUIRE(result.state.ep == libchess::squares::OffSq);
+    }
+
+    // Keeping e6 here used to let d5e6 capture a pawn that isn't there and corrupt the board
+    auto pos = libchess::Position{"4k3/8/8/3P4/8/8/8/4K3 w - e6 0 1"};
+    REQUIRE(pos.get_fen() == "4k3/8/8/3P4/8/8/8/4K3 w - - 0 1");
+    for (const auto &move : pos.legal_moves()) {
+        INFO(static_cast<std::string>(move));
+        REQUIRE(move.type() != libchess::MoveType::enpassant);
+        pos.makemove(move);
+        REQUIRE(pos.valid());
+        pos.undomove();
+    }
+}
+
+TEST_CASE("parse_fen() offsets") {
+    using pair_type = std::pair<std::string, std::size_t>;
+
+    const std::array<pair_type, 11> tests = {{
+        {"startpos", 0},
+        {"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 18},
+        {"rnbqkbnx/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 7},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1", 34},
+        {"8/8/8/8/8/8/8/4K3 w - - 0 1", 0},
+        {"4k3/8/8/8/8/8/8/4K3 x - - 0 1", 20},
+        {"  4k3/8/8/8/8/8/8/4K3   x - - 0 1", 24},
+        {"r3k2r/8/8/8/8/8/8/R3K2R w KQX - 0 1", 28},
+        {"4k3/8/8/8/3pP3/8/8/4K3 b - e6 0 1", 27},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 0 0", 28},
+        {"4k3/8/8/8/8/8/8/4K3 w - - 0 1 extra", 30},
+    }};
+
+    for (const auto &[fen, offset] : tests) {
+        INFO(fen);
+        REQUIRE(libchess::parse_fen(fen).offset == offset);
+    }
+}
+
+TEST_CASE("Position::set_fen() errors") {
+    auto pos = libchess::Position{"startpos"};
+    const auto fen = pos.get_fen();
+
+    // A failed parse leaves the position alone
+    REQUIRE(pos.try_set_fen("4k3/8/8/8/8/8/8/4K3 w K - 0 1") == libchess::FenError::Castling);
+    REQUIRE(pos.get_fen() == fen);
+    REQUIRE_THROWS_AS(pos.set_fen("garbage"), std::invalid_argument);
+    REQUIRE(pos.get_fen() == fen);
+    REQUIRE_THROWS_WITH(pos.set_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1 extra"),
+                        "Invalid FEN: unexpected text after the fullmove number at offset 30");
+    REQUIRE_THROWS_AS(libchess::Position{"8/8/8/8/8/8/8/8 w - - 0 1"}, std::invalid_argument);
+
+    // Missing clocks default to the start of a game
+    REQUIRE(pos.try_set_fen("4k3/8/8/8/8/8/8/4K3 b -  -") == libchess::FenError::None);
+    REQUIRE(pos.get_fen() == "4k3/8/8/8/8/8/8/4K3 b - - 0 1");
+
+    // The result can start a game directly
+    const auto result = libchess::parse_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    REQUIRE(result.error == libchess::FenError::None);
+    const libchess::Position from_state{result.state};
+    REQUIRE(from_state.get_fen() == "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    REQUIRE(from_state.hash() == from_state.calculate_hash());
+}
@@ -0,0 +1,77 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+namespace {
+
+void walk(libchess::Position &pos, const int depth) {
+    INFO(pos.get_fen());
+    REQUIRE(pos.has_legal_move() == !pos.legal_moves().empty());
+
+    if (depth == 0) {
+        return;
+    }
+
+    for (const auto &move : pos.legal_moves()) {
+        pos.makemove(move);
+        walk(pos, depth - 1);
+        pos.undomove();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::has_legal_move()") {
+    const std::array<std::string, 8> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        // En passant out of check
+        "8/8/8/2k5/3Pp3/8/8/4K2B b - d3 0 1",
+        // Pinned pieces
+        "k7/8/8/8/8/8/1r6/K1R4q w - - 0 1",
+        "7k/8/8/8/3b4/8/1P6/K7 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        walk(pos, 2);
+    }
+}
+
+TEST_CASE("Position::game_status()") {
+    using pair_type = std::pair<std::string, libchess::GameStatus>;
+
+    const std::array<pair_type, 7> tests = {{
+        {"startpos", libchess::GameStatus::Ongoing},
+        {"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3", libchess::GameStatus::Checkmate},
+        {"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", libchess::GameStatus::Stalemate},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 100 1", libchess::GameStatus::FiftyMoves},
+        // Checkmate takes precedence over the fifty move rule
+        {"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 100 3", libchess::GameStatus::Checkmate},
+        {"7k/5Q2/6K1/8/8/8/8/8 b - - 100 1", libchess::GameStatus::Stalemate},
+        {"8/8/8/2k5/3Pp3/8/8/4K2B b - d3 0 1", libchess::GameStatus::Ongoing},
+    }};
+
+    for (const auto &[fen, status] : tests) {
+        const libchess::Position pos{fen};
+        INFO(fen);
+        REQUIRE(pos.game_status() == status);
+        REQUIRE(pos.is_terminal() == (status != libchess::GameStatus::Ongoing));
+        REQUIRE(pos.is_checkmate() == (status == libchess::GameStatus::Checkmate));
+        REQUIRE(pos.is_stalemate() == (status == libchess::GameStatus::Stalemate));
+    }
+
+    SECTION("Threefold") {
+        auto pos = libchess::Position("startpos");
+        for (const auto &movestr : {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"}) {
+            REQUIRE(pos.game_status() == libchess::GameStatus::Ongoing);
+            pos.makemove(movestr);
+        }
+        pos.makemove("f6g8");
+        REQUIRE(pos.game_status() == libchess::GameStatus::Threefold);
+    }
+}
@@ -0,0 +1,72 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+TEST_CASE("Position::gives_check()") {
+    const std::array<std::string, 12> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        // Castling rook checks
+        "5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        "3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        // En passant discovered checks
+        "8/8/8/k2pP2R/8/8/8/4K3 w - d6 0 1",
+        "8/8/1k6/3pP3/8/8/6B1/4K3 w - d6 0 1",
+        // Promotions
+        "1k6/3P4/8/8/8/8/8/4K3 w - - 0 1",
+        "8/1P6/8/1k6/8/8/8/4K3 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+
+        // Compare against actually making every move to depth 2
+        for (const auto &move : pos.legal_moves()) {
+            INFO(pos.get_fen());
+            INFO(static_cast<std::string>(move));
+            const auto expected = [&] {
+                pos.makemove(move);
+                const auto check = pos.in_check();
+                pos.undomove();
+                return check;
+            }();
+            REQUIRE(pos.gives_check(move) == expected);
+
+            pos.makemove(move);
+            for (const auto &reply : pos.legal_moves()) {
+                INFO(pos.get_fen());
+                INFO(static_cast<std::string>(reply));
+                pos.makemove(reply);
+                const auto check = pos.in_check();
+                pos.undomove();
+                REQUIRE(pos.gives_check(reply) == check);
+            }
+            pos.undomove();
+        }
+    }
+}
+
+TEST_CASE("Position::gives_check() -- Check squares passed in") {
+    const std::array<std::string, 4> fens = {{
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        "8/8/1k6/3pP3/8/8/6B1/4K3 w - d6 0 1",
+        "8/1P6/8/1k6/8/8/8/4K3 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        libchess::Position pos{fen};
+        const auto cs = pos.check_squares();
+
+        for (const auto &move : pos.legal_moves()) {
+            INFO(static_cast<std::string>(move));
+            REQUIRE(pos.gives_check(move, cs) == pos.gives_check(move));
+        }
+    }
+}
@@ -98,3 +98,79 @@ TEST_CASE("Predict hash") {
     }
 #endif
 }
+
+TEST_CASE("Hash values") {
+#ifndef NO_HASH
+    // Keys are part of the interface, hashes stored elsewhere have to keep matching
+    const std::array<std::pair<std::string, std::uint64_t>, 3> tests = {{
+        {"startpos", 0x8285c301ca56215eULL},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 0x61b099e5caf77a4bULL},
+        {"r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1", 0xc05046d1b6a8bba6ULL},
+    }};
+
+    for (const auto &[fen, hash] : tests) {
+        const libchess::Position pos{fen};
+        INFO(fen);
+        REQUIRE(pos.hash() == hash);
+        REQUIRE(pos.calculate_hash() == hash);
+    }
+#endif
+}
+
+void test_keys(libchess::Position &pos, const int depth) noexcept {
+    if (depth == 0) {
+        return;
+    }
+
+    const auto pawn_hash = pos.pawn_hash();
+    const auto material_key = pos.material_key();
+
+    for (const auto &move : pos.legal_moves()) {
+        pos.makemove(move);
+
+        INFO(pos.get_fen());
+        REQUIRE(pos.pawn_hash() == pos.calculate_pawn_hash());
+        REQUIRE(pos.material_key() == pos.calculate_material_key());
+        REQUIRE((pos.pawn_hash() == pawn_hash) == (move.piece() != libchess::Piece::Pawn &&
+                                                  move.captured() != libchess::Piece::Pawn));
+        REQUIRE((pos.material_key() == material_key) == (!move.is_capturing() && !move.is_promoting()));
+
+        test_keys(pos, depth - 1);
+        pos.undomove();
+
+        REQUIRE(pos.pawn_hash() == pawn_hash);
+        REQUIRE(pos.material_key() == material_key);
+    }
+
+    pos.makenull();
+    REQUIRE(pos.pawn_hash() == pawn_hash);
+    REQUIRE(pos.material_key() == material_key);
+    pos.undonull();
+}
+
+TEST_CASE("Pawn hash and material key") {
+#ifndef NO_HASH
+    const std::array<std::string, 5> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "4k3/8/K6r/3pP3/8/8/8/8 w - d6 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        auto pos = libchess::Position{fen};
+        test_keys(pos, 3);
+    }
+
+    SECTION("Material only depends on the pieces present") {
+        const libchess::Position a{"4k3/8/8/3n4/8/8/3P4/4K3 w - - 0 1"};
+        const libchess::Position b{"1n2k3/8/8/8/8/2P5/8/K7 b - - 0 1"};
+        const libchess::Position c{"4k3/8/8/3b4/8/8/3P4/4K3 w - - 0 1"};
+        REQUIRE(a.material_key() == b.material_key());
+        REQUIRE(a.material_key() != c.material_key());
+        REQUIRE(a.pawn_hash() != b.pawn_hash());
+        REQUIRE(a.pawn_hash() == c.pawn_hash());
+    }
+#endif
+}
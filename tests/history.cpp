@@ -0,0 +1,46 @@
+#include <libchess/position.hpp>
+#include "catch.hpp"
+
+TEST_CASE("Position::history() -- Reserved") {
+    // Nothing is reserved until a move is made
+    const libchess::Position empty;
+    REQUIRE(empty.history().capacity() == 0);
+
+    auto pos = libchess::Position{"startpos"};
+    REQUIRE(pos.history().capacity() == 0);
+
+    pos.makemove("e2e4");
+    REQUIRE(pos.history().capacity() >= 1024);
+    pos.makemove("e7e5");
+
+    // Copies only take what's in use
+    const auto copy = pos;
+    REQUIRE(copy.history().size() == 2);
+    REQUIRE(copy.history().capacity() < 1024);
+    REQUIRE(copy.hash() == pos.hash());
+
+    libchess::Position assigned;
+    assigned = pos;
+    REQUIRE(assigned.history().size() == 2);
+
+    // Undoing the copy's moves has to work from its own history
+    assigned.undomove();
+    assigned.undomove();
+    REQUIRE(assigned.get_fen() == libchess::Position{"startpos"}.get_fen());
+    REQUIRE(pos.history().size() == 2);
+
+    // The copy makes room for a search on its first move of its own
+    auto worker = copy;
+    worker.makemove("g1f3");
+    REQUIRE(worker.history().capacity() >= 1024);
+    REQUIRE(worker.history().size() == 3);
+
+    // Null moves too
+    auto node = libchess::Position{pos.state()};
+    REQUIRE(node.history().capacity() == 0);
+    REQUIRE(node.get_fen() == pos.get_fen());
+    node.makenull();
+    REQUIRE(node.history().capacity() >= 1024);
+    node.undonull();
+    REQUIRE(node.get_fen() == pos.get_fen());
+}
@@ -1,6 +1,7 @@
 #include <array>
 #include <libchess/position.hpp>
 #include <string>
+#include <vector>
 #include "catch.hpp"
 
 TEST_CASE("Position::is_legal()") {
@@ -23,3 +24,63 @@ TEST_CASE("Position::is_legal()") {
         }
     }
 }
+
+TEST_CASE("Position::is_legal() -- Agrees with legal_moves()") {
+    const std::array<std::string, 12> fens = {{
+        "startpos",
+        "2rqr1k1/pp1bppb1/3p1npB/4n2p/3NP2P/1BN2P2/PPPQ2P1/1K1R3R b - - 1 14",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k1r1/8/8/8/8/8/8/R3K2R b KQq - 0 1",
+        "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - b3 0 23",
+        "4k3/8/4r3/3pP3/8/8/8/4K3 w - d6 0 2",
+        "8/6bb/8/8/R1pP2k1/4P3/P7/K7 b - c3 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "4k3/8/8/2KpP2r/8/8/8/8 w - d6 0 1",
+    }};
+
+    // Moves from every position, most of them won't be legal in the others
+    std::vector<libchess::Move> pool;
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        for (const auto &move : pos.legal_moves()) {
+            pool.push_back(move);
+            pos.makemove(move);
+            const auto replies = pos.legal_moves();
+            pool.insert(pool.end(), replies.begin(), replies.end());
+            pos.undomove();
+        }
+    }
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        libchess::Position pos{fen};
+        libchess::MoveList moves;
+        pos.legal_moves(moves);
+
+        for (const auto &move : pool) {
+            INFO(static_cast<std::string>(move));
+            REQUIRE(pos.is_legal(move) == moves.contains(move));
+        }
+    }
+
+    REQUIRE(!libchess::Position("startpos").is_legal(libchess::Move{}));
+}
+
+TEST_CASE("Position::is_legal() -- En passant without a pawn to capture") {
+    using namespace libchess;
+
+    const auto move = Move(MoveType::enpassant, squares::D5, Square("e6"), Piece::Pawn, Piece::Pawn);
+    REQUIRE(Position("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 0 1").is_legal(move));
+
+    // The same state with the black pawn removed, a FEN would be rejected but a state can still say so
+    auto state = Position("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 0 1").state();
+    state.colour_bb[Side::Black] ^= squares::E5;
+    state.piece_bb[Piece::Pawn] ^= squares::E5;
+    state.hash = state.calculate_hash();
+    state.pawn_hash = state.calculate_pawn_hash();
+    state.material_key = state.calculate_material_key();
+    REQUIRE(!Position(state).is_legal(move));
+}
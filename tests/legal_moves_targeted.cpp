@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+template <typename F>
+[[nodiscard]] std::vector<libchess::Move> filter(const std::vector<libchess::Move> &moves, F f) {
+    std::vector<libchess::Move> result;
+    std::copy_if(moves.begin(), moves.end(), std::back_inserter(result), f);
+    return result;
+}
+
+[[nodiscard]] bool same_moves(const std::vector<libchess::Move> &a, const std::vector<libchess::Move> &b) {
+    return a.size() == b.size() && std::is_permutation(a.begin(), a.end(), b.begin());
+}
+
+void walk(libchess::Position &pos, const int depth) {
+    const auto moves = pos.legal_moves();
+
+    INFO(pos.get_fen());
+
+    for (int i = 0; i < 64; ++i) {
+        const auto sq = libchess::Square(i);
+        INFO(static_cast<std::string>(sq));
+        REQUIRE(same_moves(pos.legal_moves_to(sq), filter(moves, [sq](const auto &m) { return m.to() == sq; })));
+        REQUIRE(same_moves(pos.legal_moves_from(sq), filter(moves, [sq](const auto &m) { return m.from() == sq; })));
+    }
+
+    for (const auto piece : {libchess::Piece::Pawn,
+                             libchess::Piece::Knight,
+                             libchess::Piece::Bishop,
+                             libchess::Piece::Rook,
+                             libchess::Piece::Queen,
+                             libchess::Piece::King}) {
+        REQUIRE(same_moves(pos.legal_moves_of(piece),
+                           filter(moves, [piece](const auto &m) { return m.piece() == piece; })));
+    }
+
+    if (depth <= 1) {
+        return;
+    }
+
+    for (const auto &move : moves) {
+        pos.makemove(move);
+        walk(pos, depth - 1);
+        pos.undomove();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::legal_moves_to() legal_moves_from() legal_moves_of()") {
+    const std::array<std::pair<std::string, int>, 5> tests = {{
+        {"startpos", 2},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 2},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 3},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 2},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 2},
+    }};
+
+    for (const auto &[fen, depth] : tests) {
+        libchess::Position pos{fen};
+        walk(pos, depth);
+    }
+
+    SECTION("Recaptures") {
+        const libchess::Position pos{"4k3/8/8/3p4/4P3/2N5/8/4K3 w - - 0 1"};
+        REQUIRE(pos.legal_moves_to(libchess::squares::D5).size() == 2);
+        REQUIRE(pos.legal_moves_from(libchess::squares::C3).size() == 7);
+        REQUIRE(pos.legal_moves_of(libchess::Piece::Knight).size() == 7);
+    }
+}
+
+TEST_CASE("Position::legal_moves_of() -- No piece") {
+    const libchess::Position pos{"startpos"};
+    REQUIRE(pos.legal_moves_of(libchess::Piece::None).empty());
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+// Compare against filtering every non-capture by making it
+void walk(libchess::Position &pos, const int depth) {
+    if (depth == 0) {
+        return;
+    }
+
+    std::vector<libchess::Move> expected;
+    for (const auto &move : pos.legal_noncaptures()) {
+        pos.makemove(move);
+        if (pos.in_check()) {
+            expected.push_back(move);
+        }
+        pos.undomove();
+    }
+
+    const auto checks = pos.legal_quiet_checks();
+
+    INFO(pos.get_fen());
+    REQUIRE(checks.size() == expected.size());
+    REQUIRE(std::is_permutation(checks.begin(), checks.end(), expected.begin()));
+
+    for (const auto &move : pos.legal_moves()) {
+        pos.makemove(move);
+        walk(pos, depth - 1);
+        pos.undomove();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::legal_quiet_checks()") {
+    const std::array<std::pair<std::string, int>, 9> tests = {{
+        {"startpos", 3},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3},
+        // Castling rook checks
+        {"5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1", 1},
+        {"3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1", 1},
+        // Discovered checks by the king and by pawn pushes
+        {"7k/8/8/8/8/8/1K6/B7 w - - 0 1", 1},
+        {"7k/8/8/8/8/8/1P6/B3K3 w - - 0 1", 1},
+    }};
+
+    for (const auto &[fen, depth] : tests) {
+        libchess::Position pos{fen};
+        walk(pos, depth);
+    }
+
+    SECTION("Move counts") {
+        // Every king move uncovers the bishop except Kc3
+        libchess::Position pos{"7k/8/8/8/8/8/1K6/B7 w - - 0 1"};
+        REQUIRE(pos.legal_quiet_checks().size() == 6);
+    }
+}
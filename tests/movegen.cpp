@@ -81,3 +81,68 @@ TEST_CASE("Movegen king") {
         REQUIRE(libchess::movegen::king_moves(sq) == libchess::Bitboard(moves));
     }
 }
+
+[[nodiscard]] libchess::Bitboard ray(libchess::Bitboard bb, const libchess::Bitboard blockers, const int dx, const int dy) {
+    libchess::Bitboard result;
+    while (true) {
+        bb = dx > 0 ? bb.east() : dx < 0 ? bb.west() : bb;
+        bb = dy > 0 ? bb.north() : dy < 0 ? bb.south() : bb;
+        if (bb.empty()) {
+            break;
+        }
+        result |= bb;
+        if (bb & blockers) {
+            break;
+        }
+    }
+    return result;
+}
+
+TEST_CASE("Movegen sliders -- All squares") {
+    using libchess::movegen::SliderBackend;
+
+    // Test every backend this CPU can run, not just the one selected at startup
+    for (const auto backend : {SliderBackend::Magic, SliderBackend::Pext}) {
+        if (!libchess::movegen::slider_backend_supported(backend)) {
+            WARN("Backend " << static_cast<int>(backend) << " not supported, skipped");
+            continue;
+        }
+
+        INFO("Backend " << static_cast<int>(backend));
+
+        std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+        for (int i = 0; i < 64; ++i) {
+            const auto sq = libchess::Square{i};
+            const auto bb = libchess::Bitboard{sq};
+
+            for (int j = 0; j < 256; ++j) {
+                // xorshift, sparse and dense occupancies
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                const auto blockers = libchess::Bitboard(j % 2 ? seed & (seed >> 11) : seed);
+
+                const auto bishop = ray(bb, blockers, 1, 1) | ray(bb, blockers, 1, -1) | ray(bb, blockers, -1, 1) |
+                                    ray(bb, blockers, -1, -1);
+                const auto rook = ray(bb, blockers, 1, 0) | ray(bb, blockers, -1, 0) | ray(bb, blockers, 0, 1) |
+                                  ray(bb, blockers, 0, -1);
+
+                REQUIRE(libchess::movegen::bishop_moves(backend, sq, blockers) == bishop);
+                REQUIRE(libchess::movegen::rook_moves(backend, sq, blockers) == rook);
+            }
+        }
+    }
+}
+
+TEST_CASE("Movegen sliders -- Selected backend") {
+    const auto backend = libchess::movegen::slider_backend();
+    REQUIRE(libchess::movegen::slider_backend_supported(backend));
+
+    for (int i = 0; i < 64; ++i) {
+        const auto sq = libchess::Square{i};
+        const auto blockers = libchess::Bitboard(0x0042002418000081ULL);
+        REQUIRE(libchess::movegen::bishop_moves(sq, blockers) ==
+                libchess::movegen::bishop_moves(backend, sq, blockers));
+        REQUIRE(libchess::movegen::rook_moves(sq, blockers) == libchess::movegen::rook_moves(backend, sq, blockers));
+    }
+}
@@ -0,0 +1,69 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+TEST_CASE("MoveList") {
+    using namespace libchess;
+
+    MoveList moves;
+    REQUIRE(moves.empty());
+    REQUIRE(moves.size() == 0);
+    REQUIRE(moves.begin() == moves.end());
+
+    moves.emplace_back(MoveType::Normal, squares::A2, squares::A3, Piece::Pawn);
+    moves.push_back(Move(MoveType::Double, squares::A2, squares::A4, Piece::Pawn));
+    REQUIRE(!moves.empty());
+    REQUIRE(moves.size() == 2);
+    REQUIRE(moves[0] == Move(MoveType::Normal, squares::A2, squares::A3, Piece::Pawn));
+    REQUIRE(moves[1] == Move(MoveType::Double, squares::A2, squares::A4, Piece::Pawn));
+    REQUIRE(moves.contains(Move(MoveType::Double, squares::A2, squares::A4, Piece::Pawn)));
+    REQUIRE(!moves.contains(Move(MoveType::Normal, squares::B2, squares::B3, Piece::Pawn)));
+
+    const auto copy = moves;
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy[1] == moves[1]);
+
+    moves.resize(1);
+    REQUIRE(moves.size() == 1);
+    moves.clear();
+    REQUIRE(moves.empty());
+}
+
+TEST_CASE("MoveList generators") {
+    const std::array<std::string, 7> fens = {{
+        "startpos",
+        "2rqr1k1/pp1bppb1/3p1npB/4n2p/3NP2P/1BN2P2/PPPQ2P1/1K1R3R b - - 1 14",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k1r1/8/8/8/8/8/8/R3K2R b KQq - 0 1",
+        "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - b3 0 23",
+        "4k3/8/4r3/3pP3/8/8/8/4K3 w - d6 0 2",
+        "8/6bb/8/8/R1pP2k1/4P3/P7/K7 b - c3 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        const libchess::Position pos{fen};
+
+        libchess::MoveList moves;
+        libchess::MoveList captures;
+        libchess::MoveList noncaptures;
+        libchess::MoveList evasions;
+        pos.legal_moves(moves);
+        pos.legal_captures(captures);
+        pos.legal_noncaptures(noncaptures);
+        pos.check_evasions(evasions);
+
+        const auto vec_moves = pos.legal_moves();
+        const auto vec_captures = pos.legal_captures();
+        const auto vec_noncaptures = pos.legal_noncaptures();
+        const auto vec_evasions = pos.check_evasions();
+
+        REQUIRE(std::vector<libchess::Move>(moves.begin(), moves.end()) == vec_moves);
+        REQUIRE(std::vector<libchess::Move>(captures.begin(), captures.end()) == vec_captures);
+        REQUIRE(std::vector<libchess::Move>(noncaptures.begin(), noncaptures.end()) == vec_noncaptures);
+        REQUIRE(std::vector<libchess::Move>(evasions.begin(), evasions.end()) == vec_evasions);
+        REQUIRE(moves.size() == pos.count_moves());
+    }
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <array>
+#include <libchess/movepicker.hpp>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+[[nodiscard]] std::vector<libchess::Move> pick_all(const libchess::Position &pos, const libchess::Move &hash_move) {
+    std::vector<libchess::Move> moves;
+    libchess::MovePicker picker{pos, hash_move};
+    while (const auto move = picker.next()) {
+        moves.push_back(move);
+    }
+    REQUIRE(picker.stage() == libchess::MovePicker::Stage::Done);
+    REQUIRE(!picker.next());
+    return moves;
+}
+
+TEST_CASE("MovePicker") {
+    const std::array<std::string, 8> fens = {{
+        "startpos",
+        "2rqr1k1/pp1bppb1/3p1npB/4n2p/3NP2P/1BN2P2/PPPQ2P1/1K1R3R b - - 1 14",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k1r1/8/8/8/8/8/8/R3K2R b KQq - 0 1",
+        "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - b3 0 23",
+        "4k3/8/4r3/3pP3/8/8/8/4K3 w - d6 0 2",
+        "8/6bb/8/8/R1pP2k1/4P3/P7/K7 b - c3 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO(fen);
+        const libchess::Position pos{fen};
+        auto legal_moves = pos.legal_moves();
+        std::ranges::sort(legal_moves, {}, [](const auto &move) {
+            return static_cast<std::string>(move);
+        });
+
+        // No hash move
+        {
+            auto moves = pick_all(pos, libchess::Move{});
+            const auto first_quiet = std::ranges::find_if(moves, [](const auto &move) {
+                return !move.is_capturing();
+            });
+            REQUIRE(std::all_of(first_quiet, moves.end(), [](const auto &move) {
+                return !move.is_capturing();
+            }));
+
+            std::ranges::sort(moves, {}, [](const auto &move) {
+                return static_cast<std::string>(move);
+            });
+            REQUIRE(moves == legal_moves);
+        }
+
+        // Every legal move as the hash move
+        for (const auto &hash_move : legal_moves) {
+            auto moves = pick_all(pos, hash_move);
+            REQUIRE(moves.front() == hash_move);
+            std::ranges::sort(moves, {}, [](const auto &move) {
+                return static_cast<std::string>(move);
+            });
+            REQUIRE(moves == legal_moves);
+        }
+    }
+}
+
+TEST_CASE("MovePicker -- Illegal hash move") {
+    const auto pos = libchess::Position{"startpos"};
+    const auto hash_move = libchess::Move(libchess::MoveType::Normal,
+                                          libchess::squares::E1,
+                                          libchess::squares::D2,
+                                          libchess::Piece::King);
+    const auto moves = pick_all(pos, hash_move);
+    REQUIRE(moves.size() == 20);
+    REQUIRE(std::ranges::find(moves, hash_move) == moves.end());
+}
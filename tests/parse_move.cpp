@@ -1,6 +1,7 @@
 #include <array>
 #include <libchess/position.hpp>
 #include <string>
+#include <string_view>
 #include "catch.hpp"
 
 TEST_CASE("Position::parse_move()") {
@@ -46,7 +47,7 @@ TEST_CASE("Position::parse_move() success") {
 }
 
 TEST_CASE("Position::parse_move() exceptions") {
-    const std::array<std::string, 7> strings = {{
+    const std::array<std::string, 14> strings = {{
         "",
         "0000",
         "longlonglong",
@@ -54,6 +55,13 @@ TEST_CASE("Position::parse_move() exceptions") {
         "b5c4",
         "h1g1",
         "a1a1",
+        "e7e5",
+        "e1g1",
+        "g1f3q",
+        "a2a3k",
+        "i2i3",
+        "a2a9",
+        "E2E4",
     }};
 
     const auto pos = libchess::Position{"rnbqk2r/pppp1ppp/4pn2/8/1bPP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 2 4"};
@@ -61,3 +69,44 @@ TEST_CASE("Position::parse_move() exceptions") {
         REQUIRE_THROWS(pos.parse_move(movestring));
     }
 }
+
+namespace {
+
+void walk(libchess::Position &pos, const int depth) {
+    for (const auto &move : pos.legal_moves()) {
+        INFO(pos.get_fen());
+        INFO(static_cast<std::string>(move));
+        REQUIRE(pos.parse_move(static_cast<std::string>(move)) == move);
+        if (depth > 1) {
+            pos.makemove(move);
+            walk(pos, depth - 1);
+            pos.undomove();
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::parse_move() tree") {
+    const std::array<std::string, 4> fens = {{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        walk(pos, 3);
+    }
+}
+
+TEST_CASE("Position::parse_move() string_view") {
+    // Moves can be read straight out of a larger buffer
+    constexpr std::string_view game = "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6";
+    auto pos = libchess::Position{"startpos"};
+    for (std::size_t i = 0; i < game.size(); i += 5) {
+        pos.makemove(game.substr(i, 4));
+    }
+    REQUIRE(pos.get_fen() == "r1bqkbnr/1ppp1ppp/p1n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 0 4");
+}
@@ -0,0 +1,58 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+namespace {
+
+void check(const libchess::Position &pos) {
+    for (int i = 0; i < 64; ++i) {
+        const auto sq = libchess::Square(i);
+        const auto piece = pos.piece_on(sq);
+        INFO(pos.get_fen());
+        INFO(static_cast<std::string>(sq));
+        if (piece == libchess::Piece::None) {
+            REQUIRE(!(pos.occupied() & sq));
+        } else {
+            REQUIRE(pos.pieces(pos.colour_on(sq), piece) & sq);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::piece_on() colour_on()") {
+    const std::array<std::string, 4> fens = {{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+    }};
+
+    // The mailbox has to survive every kind of move being made and unmade
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        check(pos);
+        for (const auto &move : pos.legal_moves()) {
+            pos.makemove(move);
+            check(pos);
+            for (const auto &reply : pos.legal_moves()) {
+                pos.makemove(reply);
+                check(pos);
+                pos.undomove();
+            }
+            pos.undomove();
+            check(pos);
+        }
+    }
+
+    SECTION("startpos") {
+        const libchess::Position pos{"startpos"};
+        REQUIRE(pos.piece_on(libchess::squares::E1) == libchess::Piece::King);
+        REQUIRE(pos.colour_on(libchess::squares::E1) == libchess::Side::White);
+        REQUIRE(pos.piece_on(libchess::squares::D8) == libchess::Piece::Queen);
+        REQUIRE(pos.colour_on(libchess::squares::D8) == libchess::Side::Black);
+        REQUIRE(pos.piece_on(libchess::squares::E3) == libchess::Piece::None);
+        REQUIRE(pos.piece_on(libchess::squares::OffSq) == libchess::Piece::None);
+    }
+}
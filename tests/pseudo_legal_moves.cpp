@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+void walk(libchess::Position &pos, const int depth) {
+    const auto moves = pos.legal_moves();
+
+    std::vector<libchess::Move> filtered;
+    for (const auto &move : pos.pseudo_legal_moves()) {
+        if (pos.is_pseudo_legal_move_legal(move)) {
+            filtered.push_back(move);
+        }
+    }
+
+    INFO(pos.get_fen());
+    REQUIRE(filtered.size() == moves.size());
+    REQUIRE(std::is_permutation(filtered.begin(), filtered.end(), moves.begin()));
+
+    if (depth <= 1) {
+        return;
+    }
+
+    for (const auto &move : moves) {
+        pos.makemove(move);
+        walk(pos, depth - 1);
+        pos.undomove();
+    }
+}
+
+// Searches the way a pseudo-legal engine would, only keeping the moves that pass the filter
+[[nodiscard]] std::uint64_t pseudo_perft(libchess::Position &pos, const int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    std::uint64_t nodes = 0;
+    for (const auto &move : pos.pseudo_legal_moves()) {
+        if (!pos.is_pseudo_legal_move_legal(move)) {
+            continue;
+        }
+        pos.makemove_pseudo(move);
+        REQUIRE(pos.in_check() == libchess::Position(pos.state()).in_check());
+        nodes += pseudo_perft(pos, depth - 1);
+        pos.undomove();
+    }
+    return nodes;
+}
+
+}  // namespace
+
+TEST_CASE("Position::pseudo_legal_moves()") {
+    const std::array<std::pair<std::string, int>, 7> tests = {{
+        {"startpos", 3},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3},
+        {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3},
+        // En passant along a rank
+        {"8/8/8/K2pP2r/8/8/8/7k w - d6 0 1", 1},
+    }};
+
+    for (const auto &[fen, depth] : tests) {
+        libchess::Position pos{fen};
+        walk(pos, depth);
+    }
+
+    SECTION("Pinned pieces") {
+        const libchess::Position pos{"4k3/4r3/8/8/8/8/4N3/4K3 w - - 0 1"};
+        const auto moves = pos.pseudo_legal_moves();
+        REQUIRE(moves.size() == 10);
+        REQUIRE(std::count_if(moves.begin(), moves.end(), [&pos](const auto &m) {
+                    return pos.is_pseudo_legal_move_legal(m);
+                }) == 4);
+    }
+}
+
+TEST_CASE("Position::makemove_pseudo()") {
+    const std::array<std::pair<std::string, std::uint64_t>, 3> tests = {{
+        {"startpos", 8902},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 97862},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 2812},
+    }};
+
+    for (const auto &[fen, nodes] : tests) {
+        INFO(fen);
+        libchess::Position pos{fen};
+        const auto before = pos.check_info();
+        REQUIRE(pseudo_perft(pos, 3) == nodes);
+        REQUIRE(pos.check_info().pinned_diagonal == before.pinned_diagonal);
+        REQUIRE(pos.check_info().king_danger == before.king_danger);
+    }
+
+    // The legal generators still work without the check info, they just work it out themselves
+    libchess::Position pos{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"};
+    for (const auto &move : pos.legal_moves()) {
+        INFO(static_cast<std::string>(move));
+        pos.makemove_pseudo(move);
+        const libchess::Position fresh{pos.state()};
+        REQUIRE(pos.legal_moves() == fresh.legal_moves());
+        REQUIRE(pos.checkers() == fresh.checkers());
+        REQUIRE(pos.pinned() == fresh.pinned());
+        pos.undomove();
+    }
+}
@@ -0,0 +1,68 @@
+#include <array>
+#include <libchess/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+TEST_CASE("Position::see()") {
+    using pair_type = std::pair<std::string, std::string>;
+
+    const std::array<std::pair<pair_type, int>, 8> tests = {{
+        // Undefended pawn
+        {{"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5"}, 100},
+        // X-rays on both sides
+        {{"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5"}, -200},
+        // Defended pawn
+        {{"4k3/8/3p4/4p3/8/8/8/4RK2 w - - 0 1", "e1e5"}, -400},
+        // Queen takes a rook defended by a king
+        {{"4k3/4r3/8/8/8/8/8/4QK2 w - - 0 1", "e1e7"}, -400},
+        // The king can't recapture a defended piece
+        {{"4k3/4r3/8/8/8/8/4R3/4QK2 w - - 0 1", "e2e7"}, 500},
+        // En passant
+        {{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"}, 100},
+        // Promotion
+        {{"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7b8q"}, 800},
+        // Quiet move to an attacked square
+        {{"4k3/8/8/6p1/8/8/8/2B1K3 w - - 0 1", "c1f4"}, -300},
+    }};
+
+    for (const auto &[pair, expected] : tests) {
+        const auto &[fen, movestr] = pair;
+        const libchess::Position pos{fen};
+        const auto move = pos.parse_move(movestr);
+        INFO(fen);
+        INFO(movestr);
+        REQUIRE(move);
+        REQUIRE(pos.see(move) == expected);
+        REQUIRE(pos.see_ge(move, expected));
+        REQUIRE(!pos.see_ge(move, expected + 1));
+    }
+}
+
+TEST_CASE("Position::see_ge()") {
+    const std::array<std::string, 5> fens = {{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+    }};
+
+    // Has to agree with the full evaluation for every threshold
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        for (const auto &move : pos.legal_moves()) {
+            pos.makemove(move);
+            for (const auto &reply : pos.legal_moves()) {
+                INFO(pos.get_fen());
+                INFO(static_cast<std::string>(reply));
+                const auto value = pos.see(reply);
+                for (int threshold = -1000; threshold <= 1000; threshold += 100) {
+                    REQUIRE(pos.see_ge(reply, threshold) == (value >= threshold));
+                }
+                REQUIRE(pos.see_ge(reply, value));
+                REQUIRE(!pos.see_ge(reply, value + 1));
+            }
+            pos.undomove();
+        }
+    }
+}
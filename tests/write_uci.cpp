@@ -0,0 +1,72 @@
+#include <array>
+#include <cstring>
+#include <libchess/position.hpp>
+#include <sstream>
+#include <string>
+#include "catch.hpp"
+
+namespace {
+
+void walk(libchess::Position &pos, const int depth) {
+    for (const auto &move : pos.legal_moves()) {
+        const auto str = static_cast<std::string>(move);
+
+        char buf[5];
+        const auto end = libchess::write_uci(buf, move);
+        REQUIRE(std::string(buf, end) == str);
+        REQUIRE(std::string(libchess::to_uci(move).data()) == str);
+
+        std::ostringstream ss;
+        ss << move;
+        REQUIRE(ss.str() == str);
+
+        if (depth > 1) {
+            pos.makemove(move);
+            walk(pos, depth - 1);
+            pos.undomove();
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("write_uci() Square") {
+    for (int i = 0; i < 64; ++i) {
+        const auto sq = libchess::Square(i);
+        char buf[2];
+        REQUIRE(libchess::write_uci(buf, sq) == buf + 2);
+        REQUIRE(std::string(buf, 2) == libchess::square_strings[i]);
+        REQUIRE(std::string(libchess::to_uci(sq).data()) == libchess::square_strings[i]);
+        REQUIRE(static_cast<std::string>(sq) == libchess::square_strings[i]);
+
+        std::ostringstream ss;
+        ss << sq;
+        REQUIRE(ss.str() == libchess::square_strings[i]);
+    }
+}
+
+TEST_CASE("write_uci() Move") {
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        libchess::Position pos{fen};
+        walk(pos, 2);
+    }
+
+    SECTION("Promotion") {
+        const auto move = libchess::Move(libchess::MoveType::promo,
+                                         libchess::squares::B7,
+                                         libchess::squares::B8,
+                                         libchess::Piece::Pawn,
+                                         libchess::Piece::None,
+                                         libchess::Piece::Queen);
+        char buf[5];
+        REQUIRE(libchess::write_uci(buf, move) == buf + 5);
+        REQUIRE(std::string(buf, 5) == "b7b8q");
+        REQUIRE(std::strlen(libchess::to_uci(move).data()) == 5);
+    }
+}